@@ -0,0 +1,434 @@
+#include "renderer3D.h"
+#include "solarsystem.h"
+#include "celestialbody.h"
+#include "camera.h"
+#include "constants.h"
+#include <algorithm>
+#include <chrono>
+#include <cmath>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <random>
+#include <string>
+#include <vector>
+
+/**
+ * @file benchmark.cpp
+ * @brief Banc de mesure reproductible du rendu
+ *
+ * Exécutable séparé (toutes les sources de src/ sauf main.cpp), sans
+ * fenêtre : Renderer3D en mode headless. Chaque trajectoire de caméra
+ * scriptée est rejouée avec un pas de simulation fixe et sans limite de
+ * FPS ; le résultat (temps par frame p50/p95/p99/max, triangles et pixels
+ * par seconde) est écrit en JSON.
+ *
+ * Exemple : benchmark --size 1920x1080 --bodies 500 --frames 300 --output bench.json
+ *
+ * --check-threads N rejoue chaque trajectoire avec 1 puis N threads et
+ * échoue (code 2) si les triangles dessinés ou les rejets du Hierarchical Z
+ * diffèrent : le parallélisme ne doit changer que le temps.
+ *
+ * --check-render lance des vérifications d'image ciblées (voir
+ * VÉRIFICATIONS) et échoue (code 2) si l'une d'elles ne passe pas.
+ */
+
+// ======================
+// OPTIONS
+// ======================
+
+struct BenchOptions {
+    int width = Constants::WINDOW_WIDTH;
+    int height = Constants::WINDOW_HEIGHT;
+    int extraBodies = 0;       // Corps ajoutés aux planètes (astéroïdes)
+    int frames = 300;          // Frames mesurées par trajectoire
+    int warmup = 30;           // Frames non mesurées avant chaque trajectoire
+    int threads = 0;           // 0 = réglage par défaut du rasterizer
+    int checkThreads = 0;      // > 0 : comparer les compteurs à 1 thread
+    bool checkRender = false;  // Vérifications d'image (régressions connues)
+    float timeStep = Constants::FIXED_TIMESTEP;
+    std::string path = "all";  // orbit, zoom, flyby ou all
+    std::string output;        // "" = sortie standard
+    bool stars = false;
+    bool impostors = false;
+};
+
+static void printUsage(const char* program) {
+    std::printf("Usage: %s [options]\n"
+                "  --size LxH       Resolution (defaut %dx%d)\n"
+                "  --bodies N       Corps supplementaires en orbite (defaut 0)\n"
+                "  --frames N       Frames mesurees par trajectoire (defaut 300)\n"
+                "  --warmup N       Frames de chauffe par trajectoire (defaut 30)\n"
+                "  --threads N      Threads de rasterisation\n"
+                "  --check-threads N Verifier que N threads donnent les memes\n"
+                "                   triangles et rejets HiZ qu'un seul\n"
+                "  --check-render   Verifications d'image (redessin partiel...)\n"
+                "  --dt SECONDES    Pas de simulation (defaut 1/%d)\n"
+                "  --path NOM       orbit, zoom, flyby ou all (defaut all)\n"
+                "  --stars          Afficher les etoiles\n"
+                "  --impostors      Corps en imposteurs\n"
+                "  --output FICHIER Resultat JSON (defaut : sortie standard)\n",
+                program, Constants::WINDOW_WIDTH, Constants::WINDOW_HEIGHT, Constants::TARGET_FPS);
+}
+
+static bool parseOptions(int argc, char* argv[], BenchOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+
+        if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 ||
+                options.width <= 0 || options.height <= 0) {
+                return false;
+            }
+        } else if (std::strcmp(arg, "--bodies") == 0 && hasValue) {
+            options.extraBodies = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--warmup") == 0 && hasValue) {
+            options.warmup = std::max(0, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--threads") == 0 && hasValue) {
+            options.threads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--check-threads") == 0 && hasValue) {
+            options.checkThreads = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--check-render") == 0) {
+            options.checkRender = true;
+        } else if (std::strcmp(arg, "--dt") == 0 && hasValue) {
+            options.timeStep = (float)std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--path") == 0 && hasValue) {
+            options.path = argv[++i];
+        } else if (std::strcmp(arg, "--output") == 0 && hasValue) {
+            options.output = argv[++i];
+        } else if (std::strcmp(arg, "--stars") == 0) {
+            options.stars = true;
+        } else if (std::strcmp(arg, "--impostors") == 0) {
+            options.impostors = true;
+        } else {
+            return false;
+        }
+    }
+
+    return options.path == "all" || options.path == "orbit" ||
+           options.path == "zoom" || options.path == "flyby";
+}
+
+// ======================
+// SCÈNE ET TRAJECTOIRES
+// ======================
+
+/**
+ * @brief Ajoute count petits corps sur des orbites entre Mars et le bord
+ *        de la scène (graine fixe : même scène à chaque exécution)
+ */
+static void addAsteroids(SolarSystem& solarSystem, int count) {
+    std::mt19937 gen(12345);
+    std::uniform_real_distribution<float> orbitDist(Constants::MARS_ORBIT + 20.0f, 400.0f);
+    std::uniform_real_distribution<float> radiusDist(0.5f, 2.5f);
+    std::uniform_real_distribution<float> greyDist(90.0f, 170.0f);
+
+    for (int i = 0; i < count; i++) {
+        float orbit = orbitDist(gen);
+        // Vitesse orbitale en r^-1.5 (Kepler), calée sur la Terre
+        float speed = Constants::EARTH_ORBITAL_SPEED *
+                      std::pow(Constants::EARTH_ORBIT / orbit, 1.5f);
+        Uint8 grey = (Uint8)greyDist(gen);
+
+        CelestialBody* body = new CelestialBody("Asteroide " + std::to_string(i),
+                                                radiusDist(gen), orbit, speed,
+                                                Constants::PLANET_ROTATION_SPEED,
+                                                SDL_Color{grey, (Uint8)(grey * 0.9f), (Uint8)(grey * 0.8f), 255});
+        // Répartir les corps sur leur orbite
+        body->update((float)i * 0.37f / speed);
+        solarSystem.addBody(body);
+    }
+}
+
+/**
+ * @brief Place la caméra sur une trajectoire à l'instant t dans [0, 1]
+ */
+static void applyCameraPath(Camera& camera, const std::string& path, float t) {
+    if (path == "orbit") {
+        // Tour complet autour du système, légèrement au-dessus du plan
+        camera.setTarget(Vector3D(0.0f, 0.0f, 0.0f));
+        camera.setAngles(Constants::TWO_PI * t, 0.35f);
+        camera.setDistance(Constants::CAMERA_DISTANCE);
+    } else if (path == "zoom") {
+        // Plongée vers le Soleil jusqu'à le voir remplir l'écran
+        float start = Constants::CAMERA_MAX_DISTANCE;
+        float end = Constants::SUN_RADIUS * 1.3f;
+        camera.setTarget(Vector3D(0.0f, 0.0f, 0.0f));
+        camera.setAngles(0.5f, 0.2f);
+        camera.setDistance(start * std::pow(end / start, t));
+    } else {
+        // Survol en rase-mottes le long de l'orbite terrestre
+        float x = -Constants::MARS_ORBIT + 2.0f * Constants::MARS_ORBIT * t;
+        camera.setTarget(Vector3D(x, 0.0f, Constants::EARTH_ORBIT));
+        camera.setAngles(Constants::HALF_PI * 0.5f, 0.15f);
+        camera.setDistance(40.0f);
+    }
+}
+
+// ======================
+// MESURE
+// ======================
+
+struct PathResult {
+    std::string name;
+    int bodies = 0;
+    std::vector<double> frameMs;
+    long long triangles = 0;
+    
+    // Rejets précoces du Hierarchical Z (cumulés sur les frames mesurées)
+    long long rejectedBodies = 0;
+    long long rejectedTriangles = 0;
+    long long rejectedTiles = 0;
+};
+
+static double percentile(const std::vector<double>& sorted, double p) {
+    // Rang le plus proche
+    size_t rank = (size_t)std::ceil(p / 100.0 * sorted.size());
+    return sorted[std::min(sorted.size() - 1, rank > 0 ? rank - 1 : 0)];
+}
+
+static PathResult runPath(const BenchOptions& options, const std::string& name, int threads) {
+    // Scène neuve par trajectoire : chaque mesure part du même état
+    Renderer3D renderer3D(nullptr, options.width, options.height);
+    Rasterizer* rasterizer = renderer3D.getRasterizer();
+    rasterizer->setLightDirection(Vector3D(0.3f, -0.5f, 1.0f));
+    rasterizer->setImpostorMode(options.impostors);
+    if (threads > 0) rasterizer->setThreadCount(threads);
+    renderer3D.setStarSeed(1);
+    if (options.stars) renderer3D.toggleStars();
+
+    SolarSystem solarSystem;
+    solarSystem.initialize();
+    addAsteroids(solarSystem, options.extraBodies);
+    Camera camera((float)options.width / options.height, Constants::CAMERA_FOV);
+
+    PathResult result;
+    result.name = name;
+    result.bodies = (int)solarSystem.getBodies().size();
+    result.frameMs.reserve(options.frames);
+
+    int total = options.warmup + options.frames;
+    for (int frame = 0; frame < total; frame++) {
+        bool measured = frame >= options.warmup;
+        float t = measured ? (float)(frame - options.warmup) / std::max(1, options.frames - 1) : 0.0f;
+
+        solarSystem.update(options.timeStep);
+        applyCameraPath(camera, name, t);
+
+        auto start = std::chrono::steady_clock::now();
+        renderer3D.render(&solarSystem, &camera);
+        renderer3D.renderInfo(Constants::TARGET_FPS, rasterizer->getFrameTriangleCount(),
+                              Constants::DEFAULT_SIMULATION_SPEED, solarSystem.getSun());
+        auto end = std::chrono::steady_clock::now();
+
+        if (measured) {
+            result.frameMs.push_back(std::chrono::duration<double, std::milli>(end - start).count());
+            result.triangles += rasterizer->getFrameTriangleCount();
+            result.rejectedBodies += rasterizer->getEarlyRejectedBodies();
+            result.rejectedTriangles += rasterizer->getEarlyRejectedTriangles();
+            result.rejectedTiles += rasterizer->getEarlyRejectedTiles();
+        }
+    }
+
+    return result;
+}
+
+// ======================
+// VÉRIFICATIONS
+// ======================
+
+/**
+ * @brief Frames partielles sans changement : le panneau ne doit pas bouger
+ *
+ * Scène figée (ni update ni caméra) : updateDirtyRects() ne trouve aucune
+ * zone, et composeHud() ne doit pas recomposer le panneau translucide sur
+ * le panneau de la frame précédente (il s'assombrirait à chaque frame).
+ */
+static bool checkIdleHud(const BenchOptions& options) {
+    Renderer3D renderer3D(nullptr, options.width, options.height);
+    Rasterizer* rasterizer = renderer3D.getRasterizer();
+    rasterizer->setLightDirection(Vector3D(0.3f, -0.5f, 1.0f));
+    renderer3D.setNominalTimings(true);
+    renderer3D.setStarSeed(1);
+
+    SolarSystem solarSystem;
+    solarSystem.initialize();
+    Camera camera((float)options.width / options.height, Constants::CAMERA_FOV);
+    // Soleil plein écran : une scène éclairée derrière le panneau translucide
+    applyCameraPath(camera, "zoom", 1.0f);
+
+    auto renderFrame = [&]() {
+        renderer3D.render(&solarSystem, &camera);
+        renderer3D.renderInfo(Constants::TARGET_FPS, rasterizer->getFrameTriangleCount(),
+                              Constants::DEFAULT_SIMULATION_SPEED, solarSystem.getSun());
+    };
+
+    // Copie de la zone du panneau
+    auto hudPixels = [&]() {
+        std::vector<Uint32> pixels;
+        int x1 = std::min(Constants::HUD_X + Constants::HUD_WIDTH, options.width);
+        int y1 = std::min(Constants::HUD_Y + Constants::HUD_HEIGHT, options.height);
+        const Uint32* color = rasterizer->getColorBuffer();
+        for (int y = Constants::HUD_Y; y < y1; y++) {
+            pixels.insert(pixels.end(), color + y * options.width + Constants::HUD_X,
+                          color + y * options.width + x1);
+        }
+        return pixels;
+    };
+
+    renderFrame();
+    std::vector<Uint32> reference = hudPixels();
+
+    bool ok = true;
+    for (int frame = 1; frame <= 2; frame++) {
+        renderFrame();
+        bool idle = renderer3D.getFrameRedraw() == FrameRedraw::NONE;
+        bool same = hudPixels() == reference;
+        std::fprintf(stderr, "[CHECK] panneau, frame fixe %d : %s, pixels %s\n", frame,
+                     idle ? "rien a redessiner" : "redessin", same ? "identiques OK" : "DIFFERENTS");
+        ok = ok && idle && same;
+    }
+    return ok;
+}
+
+/**
+ * @brief Lignes 2D dans les deux sens : les deux extrémités sont dessinées
+ *
+ * drawSegment() exclut le point d'arrivée du tracé et drawLine() l'ajoute :
+ * une ligne de droite à gauche ou de bas en haut garde son point de départ.
+ */
+static bool checkLineEndpoints() {
+    struct Line { int x0, y0, x1, y1; };
+    const Line lines[] = {
+        {5, 0, 10, 0}, {10, 0, 5, 0},      // Horizontales
+        {0, 5, 0, 12}, {0, 12, 0, 5},      // Verticales
+        {2, 3, 14, 9}, {14, 9, 2, 3},      // Diagonales (x principal)
+        {20, 1, 23, 13}, {23, 13, 20, 1}   // Diagonales (y principal)
+    };
+    const SDL_Color white = {255, 255, 255, 255};
+
+    Rasterizer rasterizer(32, 16);
+
+    bool ok = true;
+    for (const Line& line : lines) {
+        rasterizer.clear();
+        Uint32 background = rasterizer.getColorBuffer()[0];
+        rasterizer.drawLine(line.x0, line.y0, line.x1, line.y1, white);
+
+        const Uint32* color = rasterizer.getColorBuffer();
+        int lit = 0;
+        for (int i = 0; i < 32 * 16; i++) {
+            if (color[i] != background) lit++;
+        }
+        int expected = std::max(std::abs(line.x1 - line.x0), std::abs(line.y1 - line.y0)) + 1;
+        bool ends = color[line.y0 * 32 + line.x0] != background &&
+                    color[line.y1 * 32 + line.x1] != background;
+        bool same = ends && lit == expected;
+        std::fprintf(stderr, "[CHECK] ligne (%d,%d)->(%d,%d) : %d / %d pixels, extremites %s\n",
+                     line.x0, line.y0, line.x1, line.y1, lit, expected, same ? "OK" : "MANQUANTES");
+        ok = ok && same;
+    }
+    return ok;
+}
+
+static void writeJson(FILE* out, const BenchOptions& options, const std::vector<PathResult>& results) {
+    std::fprintf(out, "{\n");
+    std::fprintf(out, "  \"width\": %d,\n  \"height\": %d,\n", options.width, options.height);
+    std::fprintf(out, "  \"bodies\": %d,\n", results.empty() ? 0 : results[0].bodies);
+    std::fprintf(out, "  \"frames\": %d,\n  \"warmup\": %d,\n", options.frames, options.warmup);
+    std::fprintf(out, "  \"time_step\": %.6f,\n", options.timeStep);
+    std::fprintf(out, "  \"stars\": %s,\n  \"impostors\": %s,\n",
+                 options.stars ? "true" : "false", options.impostors ? "true" : "false");
+    std::fprintf(out, "  \"paths\": [\n");
+
+    for (size_t i = 0; i < results.size(); i++) {
+        const PathResult& r = results[i];
+        std::vector<double> sorted = r.frameMs;
+        std::sort(sorted.begin(), sorted.end());
+
+        double totalMs = 0.0;
+        for (double ms : sorted) totalMs += ms;
+        double seconds = totalMs / 1000.0;
+        double pixels = (double)options.width * options.height * sorted.size();
+
+        std::fprintf(out, "    {\n");
+        std::fprintf(out, "      \"name\": \"%s\",\n", r.name.c_str());
+        std::fprintf(out, "      \"frame_ms\": {\"mean\": %.4f, \"p50\": %.4f, \"p95\": %.4f, "
+                          "\"p99\": %.4f, \"max\": %.4f, \"min\": %.4f},\n",
+                     totalMs / sorted.size(), percentile(sorted, 50.0), percentile(sorted, 95.0),
+                     percentile(sorted, 99.0), sorted.back(), sorted.front());
+        std::fprintf(out, "      \"fps\": %.2f,\n", sorted.size() / seconds);
+        std::fprintf(out, "      \"triangles_per_frame\": %.1f,\n", (double)r.triangles / sorted.size());
+        std::fprintf(out, "      \"triangles_per_second\": %.0f,\n", r.triangles / seconds);
+        std::fprintf(out, "      \"hiz_rejected\": {\"bodies\": %lld, \"triangles\": %lld, \"tiles\": %lld},\n",
+                     r.rejectedBodies, r.rejectedTriangles, r.rejectedTiles);
+        std::fprintf(out, "      \"pixels_per_second\": %.0f\n", pixels / seconds);
+        std::fprintf(out, "    }%s\n", i + 1 < results.size() ? "," : "");
+    }
+
+    std::fprintf(out, "  ]\n}\n");
+}
+
+int main(int argc, char* argv[]) {
+    BenchOptions options;
+    if (!parseOptions(argc, argv, options)) {
+        printUsage(argv[0]);
+        return 1;
+    }
+
+    std::vector<std::string> paths;
+    if (options.path == "all") {
+        paths = {"orbit", "zoom", "flyby"};
+    } else {
+        paths = {options.path};
+    }
+
+    std::vector<PathResult> results;
+    for (const std::string& name : paths) {
+        std::fprintf(stderr, "[BENCH] %s...\n", name.c_str());
+        results.push_back(runPath(options, name, options.threads));
+    }
+    
+    bool countersMatch = true;
+    if (options.checkThreads > 0) {
+        for (const std::string& name : paths) {
+            PathResult single = runPath(options, name, 1);
+            PathResult multi = runPath(options, name, options.checkThreads);
+            bool same = single.triangles == multi.triangles &&
+                        single.rejectedBodies == multi.rejectedBodies &&
+                        single.rejectedTriangles == multi.rejectedTriangles &&
+                        single.rejectedTiles == multi.rejectedTiles;
+            std::fprintf(stderr, "[CHECK] %s, 1 / %d threads : triangles %lld / %lld, "
+                                 "rejets corps %lld / %lld, triangles %lld / %lld, tuiles %lld / %lld %s\n",
+                         name.c_str(), options.checkThreads,
+                         single.triangles, multi.triangles,
+                         single.rejectedBodies, multi.rejectedBodies,
+                         single.rejectedTriangles, multi.rejectedTriangles,
+                         single.rejectedTiles, multi.rejectedTiles,
+                         same ? "OK" : "DIFFERENT");
+            countersMatch = countersMatch && same;
+        }
+    }
+
+    bool checksPassed = true;
+    if (options.checkRender) {
+        checksPassed = checkIdleHud(options) && checksPassed;
+        checksPassed = checkLineEndpoints() && checksPassed;
+    }
+
+    FILE* out = stdout;
+    if (!options.output.empty()) {
+        out = std::fopen(options.output.c_str(), "w");
+        if (!out) {
+            std::fprintf(stderr, "[ERREUR] Ecriture: %s\n", options.output.c_str());
+            return 1;
+        }
+    }
+    writeJson(out, options, results);
+    if (out != stdout) std::fclose(out);
+
+    return countersMatch && checksPassed ? 0 : 2;
+}
\ No newline at end of file
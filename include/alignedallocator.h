@@ -0,0 +1,42 @@
+#ifndef ALIGNEDALLOCATOR_H
+#define ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+
+/**
+ * @struct AlignedAllocator
+ * @brief Allocateur std:: dont les blocs commencent sur une frontière de Alignment octets
+ * 
+ * Pour les flux de données parcourus en SIMD (std::vector<T, AlignedAllocator<T>>).
+ */
+template <typename T, std::size_t Alignment = 16>
+struct AlignedAllocator {
+    typedef T value_type;
+    
+    template <typename U>
+    struct rebind {
+        typedef AlignedAllocator<U, Alignment> other;
+    };
+    
+    AlignedAllocator() noexcept {}
+    
+    template <typename U>
+    AlignedAllocator(const AlignedAllocator<U, Alignment>&) noexcept {}
+    
+    T* allocate(std::size_t count) {
+        return static_cast<T*>(::operator new(count * sizeof(T), std::align_val_t(Alignment)));
+    }
+    
+    void deallocate(T* pointer, std::size_t) noexcept {
+        ::operator delete(pointer, std::align_val_t(Alignment));
+    }
+    
+    template <typename U>
+    bool operator==(const AlignedAllocator<U, Alignment>&) const noexcept { return true; }
+    
+    template <typename U>
+    bool operator!=(const AlignedAllocator<U, Alignment>&) const noexcept { return false; }
+};
+
+#endif // ALIGNEDALLOCATOR_H
@@ -2,9 +2,9 @@
 #define APPLICATION_H
 
 #include <SDL3/SDL.h>
-#include "Renderer3D.h"
-#include "Camera.h"
-#include "SolarSystem.h"
+#include "renderer3D.h"
+#include "camera.h"
+#include "solarsystem.h"
 
 /**
  * @class Application
@@ -32,6 +32,11 @@ private:
     bool isPaused;
     float simulationSpeed;
     
+    // Suivi des changements : sans changement, pas de rendu (attente d'événement)
+    bool skipUnchangedFrames;
+    bool frameDirty;       // Entrée utilisateur depuis la dernière frame
+    bool presentPending;   // Fenêtre à réafficher (frame en cache)
+    
     // Timing
     Uint64 lastFrameTime;
     int frameCount;
@@ -0,0 +1,28 @@
+#ifndef BITMAPFONT_H
+#define BITMAPFONT_H
+
+#include <SDL3/SDL.h>
+
+/**
+ * @file bitmapfont.h
+ * @brief Police bitmap 5x7 intégrée, sans dépendance (pas de SDL_ttf)
+ *
+ * Un glyphe = 7 lignes de 5 bits (bit 4 = colonne de gauche). ASCII
+ * imprimable ; les minuscules s'affichent en majuscules, les autres
+ * caractères en '?'.
+ */
+namespace BitmapFont {
+
+    constexpr int GLYPH_WIDTH = 5;
+    constexpr int GLYPH_HEIGHT = 7;
+    constexpr int ADVANCE = GLYPH_WIDTH + 1;      // Pas horizontal entre caractères
+    constexpr int LINE_HEIGHT = GLYPH_HEIGHT + 2; // Pas vertical entre lignes
+
+    /**
+     * @brief Lignes du glyphe d'un caractère (GLYPH_HEIGHT octets)
+     */
+    const Uint8* getGlyph(char c);
+
+} // namespace BitmapFont
+
+#endif // BITMAPFONT_H
@@ -1,8 +1,44 @@
 #ifndef CAMERA_H
 #define CAMERA_H
 
-#include "Vector3D.h"
-#include "Matrix4x4.h"
+#include "vector3D.h"
+#include "matrix4x4.h"
+
+/**
+ * @struct Plane
+ * @brief Plan a*x + b*y + c*z + d = 0, normale orientée vers l'intérieur
+ */
+struct Plane {
+    Vector3D normal;
+    float d;
+    
+    /**
+     * @brief Distance signée d'un point au plan (positive = côté intérieur)
+     */
+    float distance(const Vector3D& point) const {
+        return normal.dot(point) + d;
+    }
+};
+
+/**
+ * @struct Frustum
+ * @brief Les 6 plans du volume de vue (gauche, droite, bas, haut, proche, lointain)
+ */
+struct Frustum {
+    Plane planes[6];
+    
+    /**
+     * @brief Teste si une sphère est au moins en partie dans le volume de vue
+     */
+    bool intersectsSphere(const Vector3D& center, float radius) const {
+        for (const Plane& plane : planes) {
+            if (plane.distance(center) < -radius) {
+                return false;
+            }
+        }
+        return true;
+    }
+};
 
 /**
  * @class Camera
@@ -37,6 +73,11 @@ public:
     
     // Contrôles
     void rotate(float deltaYaw, float deltaPitch);
+    
+    /**
+     * @brief Place la caméra à des angles absolus (trajectoires scriptées)
+     */
+    void setAngles(float yaw, float pitch);
     void zoom(float delta);
     void setDistance(float dist);
     void setTarget(const Vector3D& target);
@@ -45,9 +86,25 @@ public:
     Matrix4x4 getViewMatrix() const;
     Matrix4x4 getProjectionMatrix() const;
     Matrix4x4 getViewProjectionMatrix() const;
+    
+    /**
+     * @brief Plans du frustum extraits de la matrice vue-projection (repère monde)
+     */
+    Frustum getFrustum() const;
     Vector3D getPosition() const;
     Vector3D getTarget() const;
     float getDistance() const;
+    float getFov() const;
+    float getNearPlane() const;
+    float getFarPlane() const;
+    
+    /**
+     * @brief Rayon à l'écran (pixels) d'une sphère vue par la caméra
+     * @param center Centre de la sphère (repère monde)
+     * @param radius Rayon de la sphère
+     * @param screenHeight Hauteur de l'écran en pixels
+     */
+    float getProjectedRadius(const Vector3D& center, float radius, int screenHeight) const;
     
     void setAspectRatio(float ratio);
 };
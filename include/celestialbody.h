@@ -3,9 +3,9 @@
 
 #include <SDL3/SDL.h>
 #include <string>
-#include "Vector3D.h"
-#include "Matrix4x4.h"
-#include "Sphere.h"
+#include "vector3D.h"
+#include "matrix4x4.h"
+#include "mesh.h"
 
 /**
  * @class CelestialBody
@@ -31,8 +31,8 @@ private:
     SDL_Color color;
     bool isSun;
     
-    // Géométrie
-    Sphere* sphereMesh;
+    // Niveau de détail courant (sphères unité partagées, voir MeshCache)
+    int currentLod;
     
 public:
     CelestialBody(const std::string& name,
@@ -43,8 +43,6 @@ public:
                   SDL_Color color,
                   bool isSun = false);
     
-    ~CelestialBody();
-    
     /**
      * @brief Met à jour la position et rotation
      */
@@ -52,13 +50,31 @@ public:
     
     /**
      * @brief Calcule la matrice de transformation model
+     * 
+     * Inclut la mise à l'échelle par visualRadius : le mesh est une sphère unité.
      */
     Matrix4x4 getModelMatrix() const;
     
     /**
-     * @brief Obtenir le mesh
+     * @brief Matrice qui place le cercle unité (plan XZ) sur l'orbite
+     */
+    Matrix4x4 getOrbitMatrix() const;
+    
+    /**
+     * @brief Obtenir le mesh (partagé) du niveau de détail courant
      */
-    const Sphere* getMesh() const;
+    const Mesh* getMesh() const;
+    
+    /**
+     * @brief Choisit le niveau de détail d'après le rayon à l'écran
+     * @param screenRadius Rayon projeté du corps en pixels
+     * 
+     * Un niveau ne change que si le rayon dépasse le seuil de plus de
+     * LOD_HYSTERESIS, pour éviter les allers-retours à la frontière.
+     */
+    void selectLod(float screenRadius);
+    
+    int getLodLevel() const;
     
     // Getters
     std::string getName() const;
@@ -68,6 +84,11 @@ public:
     float getOrbitalRadius() const;
     float getCurrentAngle() const;
     float getVisualRadius() const;
+    
+    /**
+     * @brief Rayon de la sphère englobante (centrée sur getPosition())
+     */
+    float getBoundingRadius() const;
 };
 
 #endif // CELESTIALBODY_H
\ No newline at end of file
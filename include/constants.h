@@ -1,10 +1,11 @@
 #ifndef CONSTANTS_H
 #define CONSTANTS_H
 
+#include "mathconstants.h"
 #include <SDL3/SDL.h>
 
 /**
- * @file Constants.h
+ * @file constants.h
  * @brief Toutes les constantes du projet en un seul endroit
  */
 
@@ -23,16 +24,14 @@ namespace Constants {
     constexpr int TARGET_FPS = 60;
     constexpr float FIXED_TIMESTEP = 1.0f / TARGET_FPS;
     constexpr int FRAME_DELAY_MS = 1000 / TARGET_FPS;  // ~16ms
+    constexpr bool SKIP_UNCHANGED_FRAMES = true;       // Pas de rendu si rien n'a changé
+    constexpr int IDLE_WAIT_MS = 500;                  // Attente max d'un événement au repos
     
-    // ======================
-    // MATHÉMATIQUES
-    // ======================
-    constexpr float PI = 3.14159265358979323846f;
-    constexpr float TWO_PI = 2.0f * PI;
-    constexpr float HALF_PI = PI / 2.0f;
-    constexpr float DEG_TO_RAD = PI / 180.0f;
-    constexpr float RAD_TO_DEG = 180.0f / PI;
-    constexpr float EPSILON = 0.0001f;  // Pour comparaisons float
+    // Profilage (touche P / --profile) : événements gardés par thread
+    constexpr int PROFILER_RING_SIZE = 65536;
+    constexpr const char* PROFILE_TRACE_FILE = "profile_trace.json";
+    
+    // Mathématiques (PI, EPSILON...) : voir mathconstants.h
     
     // ======================
     // CAMÉRA
@@ -58,6 +57,25 @@ namespace Constants {
     constexpr int SUN_SECTORS = 24;
     constexpr int SUN_STACKS = 16;
     
+    // ======================
+    // NIVEAUX DE DÉTAIL (LOD)
+    // ======================
+    // Chaque corps possède une chaîne de sphères, du plus grossier au plus fin.
+    // Le niveau est choisi d'après le rayon du corps à l'écran (pixels).
+    constexpr int LOD_LEVELS = 6;
+    constexpr int LOD_SECTORS[LOD_LEVELS] = {6, 12, SPHERE_SECTORS, SUN_SECTORS, 40, 64};
+    constexpr int LOD_STACKS[LOD_LEVELS]  = {4, 8, SPHERE_STACKS, SUN_STACKS, 28, 44};
+    
+    // Rayon à l'écran (pixels) au-delà duquel on passe au niveau suivant
+    constexpr float LOD_SWITCH_RADIUS[LOD_LEVELS - 1] = {4.0f, 12.0f, 30.0f, 60.0f, 140.0f};
+    
+    // Hystérésis autour des seuils (évite le "popping" entre deux niveaux)
+    constexpr float LOD_HYSTERESIS = 0.15f;
+    
+    // Niveaux de départ (avant la première sélection)
+    constexpr int PLANET_DEFAULT_LOD = 2;
+    constexpr int SUN_DEFAULT_LOD = 3;
+    
     // ======================
     // TAILLES DES CORPS CÉLESTES
     // ======================
@@ -75,6 +93,13 @@ namespace Constants {
     constexpr float EARTH_ORBIT = 110.0f;
     constexpr float MARS_ORBIT = 150.0f;
     
+    // Tracé des orbites : cercles unité partagés de ORBIT_MIN_SEGMENTS
+    // à ORBIT_MIN_SEGMENTS << (ORBIT_LEVELS - 1) segments, choisis pour
+    // des segments d'environ ORBIT_SEGMENT_PIXELS à l'écran
+    constexpr int ORBIT_MIN_SEGMENTS = 16;
+    constexpr int ORBIT_LEVELS = 7;
+    constexpr float ORBIT_SEGMENT_PIXELS = 6.0f;
+    
     // ======================
     // VITESSES ORBITALES (rad/s)
     // ======================
@@ -123,6 +148,24 @@ namespace Constants {
     // RENDU
     // ======================
     constexpr int MAX_STARS = 500;  // Nombre d'étoiles de fond
+    constexpr int SKY_FACE_SIZE = 1024;  // Résolution des faces du ciel étoilé (cube map)
+    constexpr int SKY_CELL_SIZE = 32;    // Côté des cellules du ciel (texels), unité de culling
+    constexpr int RASTER_TILE_SIZE = 8;  // Taille des tuiles du rasterizer (pixels)
+    constexpr int SUBPIXEL_BITS = 4;     // Précision sous-pixel du rasterizer (virgule fixe 28.4)
+    constexpr int BIN_TILE_SIZE = 64;    // Tuiles de binning multithread (multiple de RASTER_TILE_SIZE)
+    constexpr int RENDER_THREADS = 0;    // Threads de rasterisation (0 = nombre de coeurs)
+    constexpr int GUARD_BAND_PIXELS = 2048;  // Marge hors écran avant clipping en x/y
+    constexpr bool INCREMENTAL_REDRAW = true;       // Ne redessiner que les zones qui changent
+    constexpr int DIRTY_RECT_MARGIN = 2;            // Marge autour des zones à redessiner (pixels)
+    constexpr float DIRTY_RECT_MAX_COVERAGE = 0.5f; // Au-delà (fraction de l'écran) : redessin complet
+    
+    // Panneau d'informations
+    constexpr int HUD_X = 10;
+    constexpr int HUD_Y = 10;
+    constexpr int HUD_WIDTH = 250;
+    constexpr int HUD_HEIGHT = 120;
+    constexpr int HUD_PADDING = 6;          // Marge intérieure (pixels)
+    constexpr int HUD_REFRESH_FRAMES = 10;  // Frames moyennées entre deux mises à jour du panneau
     
 } // namespace Constants
 
@@ -0,0 +1,66 @@
+#ifndef HEADLESSRUNNER_H
+#define HEADLESSRUNNER_H
+
+#include <string>
+
+/**
+ * @struct HeadlessOptions
+ * @brief Réglages d'une exécution sans fenêtre (voir main.cpp --help)
+ */
+struct HeadlessOptions {
+    int width;
+    int height;
+    int frames;              // Nombre de frames simulées et rendues
+    float timeStep;          // Pas de simulation par frame (secondes)
+    std::string output;      // Fichier(s) de sortie, "" = aucun ; %d = numéro de frame
+    int outputEvery;         // Avec %d : une image toutes les N frames
+    unsigned int starSeed;   // Graine du ciel étoilé
+    std::string profile;     // Trace Chrome de l'exécution, "" = pas de profilage
+    bool stars;
+    bool orbits;
+    bool info;
+    bool wireframe;
+    bool impostors;
+    
+    HeadlessOptions();
+};
+
+/**
+ * @class HeadlessRunner
+ * @brief Simulation et rendu sans fenêtre ni sous-système vidéo SDL
+ * 
+ * Pour les fermes de rendu, la CI et les mesures : le rasterizer écrit
+ * dans son framebuffer en mémoire, les frames sont enregistrées en PPM
+ * ou PNG. Le pas de temps est fixe et le ciel a une graine fixe, donc
+ * deux exécutions identiques produisent les mêmes images.
+ */
+class HeadlessRunner {
+private:
+    HeadlessOptions options;
+    
+    /**
+     * @brief Chemin de l'image d'une frame, "" si elle n'est pas enregistrée
+     */
+    std::string outputPath(int frame) const;
+    
+public:
+    explicit HeadlessRunner(const HeadlessOptions& options);
+    
+    /**
+     * @brief Remplace le numéro de frame dans le motif --output
+     * @param path Chemin obtenu ("%%" donne "%")
+     * @param numbered true si le motif contient un numéro (%d, %Nd ou %0Nd)
+     * @return false si le motif contient une autre conversion ou plusieurs
+     *         numéros (le motif n'est jamais passé à printf)
+     */
+    static bool expandOutputPattern(const std::string& pattern, int frame,
+                                    std::string& path, bool& numbered);
+    
+    /**
+     * @brief Exécute toutes les frames
+     * @return Code de sortie du programme (0 = succès)
+     */
+    int run();
+};
+
+#endif // HEADLESSRUNNER_H
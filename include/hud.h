@@ -0,0 +1,98 @@
+#ifndef HUD_H
+#define HUD_H
+
+#include <SDL3/SDL.h>
+#include <string>
+#include <vector>
+
+/**
+ * @class Hud
+ * @brief Panneau de performances : texte bitmap et courbe des temps de frame
+ * 
+ * Le panneau est dessiné une fois dans un calque ARGB prémultiplié, puis
+ * simplement mélangé au framebuffer à chaque frame (Rasterizer::blendImage).
+ * Les valeurs affichées sont des moyennes sur HUD_REFRESH_FRAMES frames et
+ * le calque n'est redessiné que si le texte ou la courbe ont changé.
+ */
+class Hud {
+public:
+    /**
+     * @brief Étapes de la frame mesurées et affichées
+     */
+    enum Stage {
+        STAGE_STARS,
+        STAGE_BODIES,
+        STAGE_ORBITS,
+        STAGE_PRESENT,
+        STAGE_COUNT
+    };
+    
+private:
+    int width;
+    int height;
+    std::vector<Uint32> layer;  // ARGB prémultiplié, width x height
+    
+    // Fenêtre de mesure en cours
+    int windowFrames;
+    double windowFrameMs;
+    double windowStageMs[STAGE_COUNT];
+    
+    // Temps des dernières frames (tampon circulaire, une colonne par frame)
+    std::vector<float> history;
+    int historyHead;
+    int historyCount;
+    
+    // Contenu actuel du calque
+    bool layerValid;
+    std::vector<std::string> lines;
+    std::vector<int> bars;          // Hauteur des barres de la courbe (pixels)
+    int redrawCount;
+    
+    int getGraphTop() const;
+    int getGraphHeight() const;
+    
+    /**
+     * @brief Redessine le calque avec les lignes et barres courantes
+     */
+    void redraw(float budgetMs);
+    
+    void fillRect(int x, int y, int w, int h, Uint32 pixel);
+    void drawText(const std::string& text, int x, int y, Uint32 pixel);
+    
+public:
+    /**
+     * @param width Largeur du panneau (Constants::HUD_WIDTH)
+     * @param height Hauteur du panneau (Constants::HUD_HEIGHT)
+     */
+    Hud(int width, int height);
+    
+    /**
+     * @brief Ajoute le temps d'une étape à la frame en cours
+     */
+    void addStageTime(Stage stage, double ms);
+    
+    /**
+     * @brief Termine une frame ; met à jour le calque toutes les HUD_REFRESH_FRAMES
+     * @param frameMs Durée de la frame (intervalle entre deux frames)
+     * @param timingsMeasured false : temps des étapes inconnus, affichés "--"
+     * @return true si le calque a été redessiné
+     */
+    bool endFrame(double frameMs, int fps, int triangles, int culledTriangles,
+                  float simSpeed, bool timingsMeasured);
+    
+    /**
+     * @brief Oublie les mesures de la fenêtre en cours (panneau masqué)
+     */
+    void discardWindow();
+    
+    const Uint32* getLayer() const { return layer.data(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    
+    /**
+     * @brief Nombre de fois où le calque a été redessiné
+     */
+    int getRedrawCount() const { return redrawCount; }
+};
+
+#endif // HUD_H
@@ -0,0 +1,35 @@
+#ifndef IMAGEWRITER_H
+#define IMAGEWRITER_H
+
+#include <SDL3/SDL.h>
+#include <string>
+
+/**
+ * @file imagewriter.h
+ * @brief Écriture du framebuffer (ARGB8888) dans un fichier image
+ *
+ * Sans dépendance externe : PPM binaire (P6) et PNG non compressé
+ * (blocs deflate "stored"), lisibles par tous les outils courants.
+ */
+namespace ImageWriter {
+
+    /**
+     * @brief Écrit une image PPM binaire (P6)
+     * @return false si le fichier n'a pas pu être écrit
+     */
+    bool writePPM(const std::string& path, const Uint32* pixels, int width, int height);
+
+    /**
+     * @brief Écrit une image PNG RGB 8 bits non compressée
+     * @return false si le fichier n'a pas pu être écrit
+     */
+    bool writePNG(const std::string& path, const Uint32* pixels, int width, int height);
+
+    /**
+     * @brief Écrit en PNG si le chemin finit par ".png", en PPM sinon
+     */
+    bool write(const std::string& path, const Uint32* pixels, int width, int height);
+
+} // namespace ImageWriter
+
+#endif // IMAGEWRITER_H
@@ -0,0 +1,26 @@
+#ifndef MATHCONSTANTS_H
+#define MATHCONSTANTS_H
+
+/**
+ * @file mathconstants.h
+ * @brief Constantes mathématiques, sans dépendance
+ *
+ * Séparées de constants.h (qui inclut SDL) pour que Vector3D, Matrix4x4 et
+ * les tables constexpr restent légers à inclure.
+ */
+
+namespace Constants {
+    
+    // ======================
+    // MATHÉMATIQUES
+    // ======================
+    constexpr float PI = 3.14159265358979323846f;
+    constexpr float TWO_PI = 2.0f * PI;
+    constexpr float HALF_PI = PI / 2.0f;
+    constexpr float DEG_TO_RAD = PI / 180.0f;
+    constexpr float RAD_TO_DEG = 180.0f / PI;
+    constexpr float EPSILON = 0.0001f;  // Pour comparaisons float
+
+} // namespace Constants
+
+#endif // MATHCONSTANTS_H
@@ -1,21 +1,46 @@
 #ifndef MATRIX4X4_H
 #define MATRIX4X4_H
 
-#include "Vector3D.h"
+#include "vector3D.h"
+#include "mathconstants.h"
+#include <cmath>
+#include <type_traits>
+
+// SSE2 : toujours présent en x86-64, optionnel en 32 bits
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define MATRIX4X4_SSE2 1
+#include <emmintrin.h>
+#endif
+
+/**
+ * @struct Vector4D
+ * @brief Point en coordonnées homogènes (x, y, z, w)
+ * 
+ * Utilisé pour les sommets en clip space, avant la division perspective.
+ */
+struct Vector4D {
+    float x, y, z, w;
+};
 
 /**
  * @class Matrix4x4
  * @brief Matrice 4x4 pour les transformations 3D
  * 
- * Représentation d'une matrice 4x4 en row-major order
+ * Représentation d'une matrice 4x4 en row-major order, lignes alignées
+ * sur 16 octets
  * Utilisée pour :
  * - Transformations géométriques (translation, rotation, scale)
  * - Matrices de vue (caméra)
  * - Matrices de projection (perspective)
+ * 
+ * Défini dans ce header, sauf print() (matrix4x4.cpp) : tout ce qui
+ * n'appelle pas cos/sin/tan/sqrt est constexpr, les matrices fixes
+ * (identité, translations, projections à focale connue) peuvent donc être
+ * calculées à la compilation.
  */
 class Matrix4x4 {
 private:
-    float m[4][4];  // Matrice 4x4 en row-major
+    alignas(16) float m[4][4];  // Matrice 4x4 en row-major
     
 public:
     // ======================
@@ -25,12 +50,12 @@ public:
     /**
      * @brief Constructeur par défaut (matrice identité)
      */
-    Matrix4x4();
+    constexpr Matrix4x4() noexcept;
     
     /**
      * @brief Constructeur avec tableau
      */
-    Matrix4x4(float values[4][4]);
+    constexpr Matrix4x4(const float values[4][4]) noexcept;
     
     // ======================
     // MATRICES SPÉCIALES
@@ -39,13 +64,13 @@ public:
     /**
      * @brief Crée une matrice identité
      */
-    static Matrix4x4 identity();
+    static constexpr Matrix4x4 identity() noexcept;
     
     /**
      * @brief Crée une matrice de translation
      * @param x, y, z Déplacements sur chaque axe
      */
-    static Matrix4x4 translation(float x, float y, float z);
+    static constexpr Matrix4x4 translation(float x, float y, float z) noexcept;
     
     /**
      * @brief Crée une matrice de rotation autour de l'axe X
@@ -69,7 +94,7 @@ public:
      * @brief Crée une matrice de mise à l'échelle
      * @param sx, sy, sz Facteurs d'échelle sur chaque axe
      */
-    static Matrix4x4 scale(float sx, float sy, float sz);
+    static constexpr Matrix4x4 scale(float sx, float sy, float sz) noexcept;
     
     /**
      * @brief Crée une matrice de vue (caméra)
@@ -90,6 +115,13 @@ public:
      */
     static Matrix4x4 perspective(float fov, float aspect, float near, float far);
     
+    /**
+     * @brief Projection perspective à partir de tan(fov / 2), calculable à la compilation
+     * @param tanHalfFov Tangente du demi-angle vertical
+     */
+    static constexpr Matrix4x4 perspectiveFromTan(float tanHalfFov, float aspect,
+                                                  float near, float far) noexcept;
+    
     // ======================
     // OPÉRATEURS
     // ======================
@@ -97,7 +129,7 @@ public:
     /**
      * @brief Multiplication de matrices
      */
-    Matrix4x4 operator*(const Matrix4x4& other) const;
+    constexpr Matrix4x4 operator*(const Matrix4x4& other) const noexcept;
     
     /**
      * @brief Multiplication matrice * vecteur (transformation de point)
@@ -105,6 +137,12 @@ public:
      */
     Vector3D operator*(const Vector3D& vec) const;
     
+    /**
+     * @brief Comparaison exacte (détection de changement d'une frame à l'autre)
+     */
+    constexpr bool operator==(const Matrix4x4& other) const noexcept;
+    constexpr bool operator!=(const Matrix4x4& other) const noexcept;
+    
     // ======================
     // TRANSFORMATIONS
     // ======================
@@ -116,12 +154,37 @@ public:
      */
     Vector3D transformPoint(const Vector3D& point) const;
     
+    /**
+     * @brief Transforme un point 3D en coordonnées homogènes
+     * @param point Point à transformer (w = 1)
+     * @return Point en clip space, sans division perspective
+     */
+    constexpr Vector4D transformHomogeneous(const Vector3D& point) const noexcept;
+    
     /**
      * @brief Transforme un vecteur 3D (sans translation)
      * @param vec Vecteur à transformer
      * @return Vecteur transformé (normales, directions)
      */
-    Vector3D transformVector(const Vector3D& vec) const;
+    constexpr Vector3D transformVector(const Vector3D& vec) const noexcept;
+    
+    // ======================
+    // TRAITEMENT PAR LOTS
+    // ======================
+    
+    /**
+     * @brief Transforme count points en clip space (transformHomogeneous en lot)
+     * @param out count résultats consécutifs
+     * 
+     * 4 points par itération en SSE2, mêmes résultats que point par point.
+     */
+    void transformHomogeneousBatch(const Vector3D* points, int count, Vector4D* out) const noexcept;
+    
+    /**
+     * @brief Transforme count directions (sans translation) puis les normalise
+     * @param out count résultats consécutifs (nuls si la direction est nulle)
+     */
+    void transformNormalsBatch(const Vector3D* normals, int count, Vector3D* out) const noexcept;
     
     // ======================
     // ACCÈS AUX ÉLÉMENTS
@@ -130,17 +193,17 @@ public:
     /**
      * @brief Accès en lecture/écriture
      */
-    float& at(int row, int col);
+    constexpr float& at(int row, int col) noexcept;
     
     /**
      * @brief Accès en lecture seule
      */
-    float at(int row, int col) const;
+    constexpr float at(int row, int col) const noexcept;
     
     /**
      * @brief Obtenir un pointeur vers les données (pour OpenGL si besoin)
      */
-    const float* data() const;
+    constexpr const float* data() const noexcept;
     
     // ======================
     // UTILITAIRES
@@ -154,12 +217,392 @@ public:
     /**
      * @brief Transpose la matrice
      */
-    Matrix4x4 transposed() const;
+    constexpr Matrix4x4 transposed() const noexcept;
     
     /**
      * @brief Calcule l'inverse (simplifié pour transformations affines)
      */
-    Matrix4x4 inverse() const;
+    constexpr Matrix4x4 inverse() const noexcept;
 };
 
+static_assert(std::is_trivially_copyable<Matrix4x4>::value, "Matrix4x4 doit rester copiable par memcpy");
+
+// ======================
+// CONSTRUCTEURS
+// ======================
+
+constexpr Matrix4x4::Matrix4x4() noexcept
+    : m{{1.0f, 0.0f, 0.0f, 0.0f},
+        {0.0f, 1.0f, 0.0f, 0.0f},
+        {0.0f, 0.0f, 1.0f, 0.0f},
+        {0.0f, 0.0f, 0.0f, 1.0f}} {}
+
+constexpr Matrix4x4::Matrix4x4(const float values[4][4]) noexcept : m{} {
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            m[i][j] = values[i][j];
+        }
+    }
+}
+
+// ======================
+// MATRICES SPÉCIALES
+// ======================
+
+constexpr Matrix4x4 Matrix4x4::identity() noexcept {
+    return Matrix4x4();
+}
+
+constexpr Matrix4x4 Matrix4x4::translation(float x, float y, float z) noexcept {
+    Matrix4x4 result;
+    result.m[0][3] = x;
+    result.m[1][3] = y;
+    result.m[2][3] = z;
+    return result;
+}
+
+inline Matrix4x4 Matrix4x4::rotationX(float angle) {
+    Matrix4x4 result;
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    
+    result.m[1][1] = c;
+    result.m[1][2] = -s;
+    result.m[2][1] = s;
+    result.m[2][2] = c;
+    
+    return result;
+}
+
+inline Matrix4x4 Matrix4x4::rotationY(float angle) {
+    Matrix4x4 result;
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    
+    result.m[0][0] = c;
+    result.m[0][2] = s;
+    result.m[2][0] = -s;
+    result.m[2][2] = c;
+    
+    return result;
+}
+
+inline Matrix4x4 Matrix4x4::rotationZ(float angle) {
+    Matrix4x4 result;
+    float c = std::cos(angle);
+    float s = std::sin(angle);
+    
+    result.m[0][0] = c;
+    result.m[0][1] = -s;
+    result.m[1][0] = s;
+    result.m[1][1] = c;
+    
+    return result;
+}
+
+constexpr Matrix4x4 Matrix4x4::scale(float sx, float sy, float sz) noexcept {
+    Matrix4x4 result;
+    result.m[0][0] = sx;
+    result.m[1][1] = sy;
+    result.m[2][2] = sz;
+    return result;
+}
+
+inline Matrix4x4 Matrix4x4::lookAt(const Vector3D& eye, 
+                                   const Vector3D& target, 
+                                   const Vector3D& up) {
+    // Calculer les axes de la caméra
+    Vector3D zAxis = (eye - target).normalized();  // Forward
+    Vector3D xAxis = up.cross(zAxis).normalized(); // Right
+    Vector3D yAxis = zAxis.cross(xAxis);           // Up
+    
+    Matrix4x4 result;
+    
+    // Rotation
+    result.m[0][0] = xAxis.x;
+    result.m[0][1] = xAxis.y;
+    result.m[0][2] = xAxis.z;
+    
+    result.m[1][0] = yAxis.x;
+    result.m[1][1] = yAxis.y;
+    result.m[1][2] = yAxis.z;
+    
+    result.m[2][0] = zAxis.x;
+    result.m[2][1] = zAxis.y;
+    result.m[2][2] = zAxis.z;
+    
+    // Translation
+    result.m[0][3] = -xAxis.dot(eye);
+    result.m[1][3] = -yAxis.dot(eye);
+    result.m[2][3] = -zAxis.dot(eye);
+    
+    return result;
+}
+
+inline Matrix4x4 Matrix4x4::perspective(float fov, float aspect, float near, float far) {
+    // Convertir FOV en radians et calculer la tangente
+    float tanHalfFov = std::tan(fov * 0.5f * 3.14159265f / 180.0f);
+    return perspectiveFromTan(tanHalfFov, aspect, near, far);
+}
+
+constexpr Matrix4x4 Matrix4x4::perspectiveFromTan(float tanHalfFov, float aspect,
+                                                  float near, float far) noexcept {
+    Matrix4x4 result;
+    
+    // Initialiser à zéro
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            result.m[i][j] = 0.0f;
+        }
+    }
+    
+    // Matrice de projection perspective
+    result.m[0][0] = 1.0f / (aspect * tanHalfFov);
+    result.m[1][1] = 1.0f / tanHalfFov;
+    result.m[2][2] = -(far + near) / (far - near);
+    result.m[2][3] = -(2.0f * far * near) / (far - near);
+    result.m[3][2] = -1.0f;
+    result.m[3][3] = 0.0f;
+    
+    return result;
+}
+
+// ======================
+// OPÉRATEURS
+// ======================
+
+constexpr Matrix4x4 Matrix4x4::operator*(const Matrix4x4& other) const noexcept {
+    Matrix4x4 result;
+    
+    // Ligne i du résultat = combinaison des lignes de other (vectorisable)
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            result.m[i][j] = m[i][0] * other.m[0][j] + m[i][1] * other.m[1][j] +
+                             m[i][2] * other.m[2][j] + m[i][3] * other.m[3][j];
+        }
+    }
+    
+    return result;
+}
+
+inline Vector3D Matrix4x4::operator*(const Vector3D& vec) const {
+    return transformPoint(vec);
+}
+
+constexpr bool Matrix4x4::operator==(const Matrix4x4& other) const noexcept {
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            if (m[i][j] != other.m[i][j]) return false;
+        }
+    }
+    return true;
+}
+
+constexpr bool Matrix4x4::operator!=(const Matrix4x4& other) const noexcept {
+    return !(*this == other);
+}
+
+// ======================
+// TRANSFORMATIONS
+// ======================
+
+inline Vector3D Matrix4x4::transformPoint(const Vector3D& point) const {
+    // Transformer le point en coordonnées homogènes
+    float x = m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z + m[0][3];
+    float y = m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z + m[1][3];
+    float z = m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z + m[2][3];
+    float w = m[3][0] * point.x + m[3][1] * point.y + m[3][2] * point.z + m[3][3];
+    
+    // Division perspective
+    if (std::abs(w) > 0.0001f) {
+        return Vector3D(x / w, y / w, z / w);
+    }
+    
+    return Vector3D(x, y, z);
+}
+
+constexpr Vector4D Matrix4x4::transformHomogeneous(const Vector3D& point) const noexcept {
+    return Vector4D{
+        m[0][0] * point.x + m[0][1] * point.y + m[0][2] * point.z + m[0][3],
+        m[1][0] * point.x + m[1][1] * point.y + m[1][2] * point.z + m[1][3],
+        m[2][0] * point.x + m[2][1] * point.y + m[2][2] * point.z + m[2][3],
+        m[3][0] * point.x + m[3][1] * point.y + m[3][2] * point.z + m[3][3]
+    };
+}
+
+constexpr Vector3D Matrix4x4::transformVector(const Vector3D& vec) const noexcept {
+    // Transformer sans la translation (w=0)
+    float x = m[0][0] * vec.x + m[0][1] * vec.y + m[0][2] * vec.z;
+    float y = m[1][0] * vec.x + m[1][1] * vec.y + m[1][2] * vec.z;
+    float z = m[2][0] * vec.x + m[2][1] * vec.y + m[2][2] * vec.z;
+    
+    return Vector3D(x, y, z);
+}
+
+// ======================
+// TRAITEMENT PAR LOTS
+// ======================
+
+inline void Matrix4x4::transformHomogeneousBatch(const Vector3D* points, int count,
+                                                 Vector4D* out) const noexcept {
+    int i = 0;
+    
+#ifdef MATRIX4X4_SSE2
+    // Une composante par registre, 4 points par registre ; mêmes opérations,
+    // dans le même ordre, que transformHomogeneous()
+    __m128 c[4][4];
+    for (int row = 0; row < 4; row++) {
+        for (int col = 0; col < 4; col++) {
+            c[row][col] = _mm_set1_ps(m[row][col]);
+        }
+    }
+    
+    for (; i + 4 <= count; i += 4) {
+        const Vector3D& p0 = points[i];
+        const Vector3D& p1 = points[i + 1];
+        const Vector3D& p2 = points[i + 2];
+        const Vector3D& p3 = points[i + 3];
+        __m128 x = _mm_set_ps(p3.x, p2.x, p1.x, p0.x);
+        __m128 y = _mm_set_ps(p3.y, p2.y, p1.y, p0.y);
+        __m128 z = _mm_set_ps(p3.z, p2.z, p1.z, p0.z);
+        
+        __m128 r[4];
+        for (int row = 0; row < 4; row++) {
+            __m128 v = _mm_add_ps(_mm_mul_ps(c[row][0], x), _mm_mul_ps(c[row][1], y));
+            v = _mm_add_ps(v, _mm_mul_ps(c[row][2], z));
+            r[row] = _mm_add_ps(v, c[row][3]);
+        }
+        
+        // (x0..x3, y0..y3, ...) -> (x0, y0, z0, w0), ...
+        _MM_TRANSPOSE4_PS(r[0], r[1], r[2], r[3]);
+        _mm_storeu_ps(&out[i].x, r[0]);
+        _mm_storeu_ps(&out[i + 1].x, r[1]);
+        _mm_storeu_ps(&out[i + 2].x, r[2]);
+        _mm_storeu_ps(&out[i + 3].x, r[3]);
+    }
+#endif
+    
+    for (; i < count; i++) {
+        out[i] = transformHomogeneous(points[i]);
+    }
+}
+
+inline void Matrix4x4::transformNormalsBatch(const Vector3D* normals, int count,
+                                             Vector3D* out) const noexcept {
+    int i = 0;
+    
+#ifdef MATRIX4X4_SSE2
+    __m128 c[3][3];
+    for (int row = 0; row < 3; row++) {
+        for (int col = 0; col < 3; col++) {
+            c[row][col] = _mm_set1_ps(m[row][col]);
+        }
+    }
+    const __m128 epsilon = _mm_set1_ps(Constants::EPSILON);
+    
+    for (; i + 4 <= count; i += 4) {
+        const Vector3D& n0 = normals[i];
+        const Vector3D& n1 = normals[i + 1];
+        const Vector3D& n2 = normals[i + 2];
+        const Vector3D& n3 = normals[i + 3];
+        __m128 x = _mm_set_ps(n3.x, n2.x, n1.x, n0.x);
+        __m128 y = _mm_set_ps(n3.y, n2.y, n1.y, n0.y);
+        __m128 z = _mm_set_ps(n3.z, n2.z, n1.z, n0.z);
+        
+        __m128 r[3];
+        for (int row = 0; row < 3; row++) {
+            __m128 v = _mm_add_ps(_mm_mul_ps(c[row][0], x), _mm_mul_ps(c[row][1], y));
+            r[row] = _mm_add_ps(v, _mm_mul_ps(c[row][2], z));
+        }
+        
+        // Normalisation ; direction nulle -> (0, 0, 0) comme Vector3D::normalize()
+        __m128 len = _mm_add_ps(_mm_mul_ps(r[0], r[0]), _mm_mul_ps(r[1], r[1]));
+        len = _mm_sqrt_ps(_mm_add_ps(len, _mm_mul_ps(r[2], r[2])));
+        __m128 valid = _mm_cmpge_ps(len, epsilon);
+        
+        alignas(16) float result[3][4];
+        for (int axis = 0; axis < 3; axis++) {
+            _mm_store_ps(result[axis], _mm_and_ps(_mm_div_ps(r[axis], len), valid));
+        }
+        for (int k = 0; k < 4; k++) {
+            out[i + k] = Vector3D(result[0][k], result[1][k], result[2][k]);
+        }
+    }
+#endif
+    
+    for (; i < count; i++) {
+        Vector3D n = transformVector(normals[i]);
+        float len = n.length();
+        out[i] = len < Constants::EPSILON ? Vector3D(0.0f, 0.0f, 0.0f) : n / len;
+    }
+}
+
+// ======================
+// ACCÈS AUX ÉLÉMENTS
+// ======================
+
+constexpr float& Matrix4x4::at(int row, int col) noexcept {
+    return m[row][col];
+}
+
+constexpr float Matrix4x4::at(int row, int col) const noexcept {
+    return m[row][col];
+}
+
+constexpr const float* Matrix4x4::data() const noexcept {
+    return &m[0][0];
+}
+
+// ======================
+// UTILITAIRES
+// ======================
+
+constexpr Matrix4x4 Matrix4x4::transposed() const noexcept {
+    Matrix4x4 result;
+    for (int i = 0; i < 4; i++) {
+        for (int j = 0; j < 4; j++) {
+            result.m[i][j] = m[j][i];
+        }
+    }
+    return result;
+}
+
+constexpr Matrix4x4 Matrix4x4::inverse() const noexcept {
+    // Inverse simplifié pour matrices de transformation
+    // Pour une matrice complète, il faudrait l'algorithme de Gauss-Jordan
+    Matrix4x4 result;
+    
+    // Extraire la rotation/scale (3x3)
+    float det = m[0][0] * (m[1][1] * m[2][2] - m[2][1] * m[1][2])
+              - m[0][1] * (m[1][0] * m[2][2] - m[1][2] * m[2][0])
+              + m[0][2] * (m[1][0] * m[2][1] - m[1][1] * m[2][0]);
+    
+    if (det > -Constants::EPSILON && det < Constants::EPSILON) {
+        // Matrice non inversible, retourner l'identité
+        return identity();
+    }
+    
+    float invDet = 1.0f / det;
+    
+    // Inverse de la partie 3x3
+    result.m[0][0] = (m[1][1] * m[2][2] - m[2][1] * m[1][2]) * invDet;
+    result.m[0][1] = (m[0][2] * m[2][1] - m[0][1] * m[2][2]) * invDet;
+    result.m[0][2] = (m[0][1] * m[1][2] - m[0][2] * m[1][1]) * invDet;
+    
+    result.m[1][0] = (m[1][2] * m[2][0] - m[1][0] * m[2][2]) * invDet;
+    result.m[1][1] = (m[0][0] * m[2][2] - m[0][2] * m[2][0]) * invDet;
+    result.m[1][2] = (m[1][0] * m[0][2] - m[0][0] * m[1][2]) * invDet;
+    
+    result.m[2][0] = (m[1][0] * m[2][1] - m[2][0] * m[1][1]) * invDet;
+    result.m[2][1] = (m[2][0] * m[0][1] - m[0][0] * m[2][1]) * invDet;
+    result.m[2][2] = (m[0][0] * m[1][1] - m[1][0] * m[0][1]) * invDet;
+    
+    // Inverse de la translation
+    result.m[0][3] = -(result.m[0][0] * m[0][3] + result.m[0][1] * m[1][3] + result.m[0][2] * m[2][3]);
+    result.m[1][3] = -(result.m[1][0] * m[0][3] + result.m[1][1] * m[1][3] + result.m[1][2] * m[2][3]);
+    result.m[2][3] = -(result.m[2][0] * m[0][3] + result.m[2][1] * m[1][3] + result.m[2][2] * m[2][3]);
+    
+    return result;
+}
+
 #endif // MATRIX4X4_H
\ No newline at end of file
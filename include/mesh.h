@@ -1,44 +1,91 @@
 #ifndef MESH_H
 #define MESH_H
 
-#include "Vector3D.h"
+#include <SDL3/SDL.h>
+#include "vector3D.h"
+#include "alignedallocator.h"
 #include <vector>
 
 /**
- * @struct Vertex
- * @brief Structure représentant un sommet 3D
+ * @struct TexCoord
+ * @brief Coordonnées de texture d'un sommet
  */
-struct Vertex {
-    Vector3D position;  // Position 3D
-    Vector3D normal;    // Normale (pour l'éclairage)
-    float u, v;         // Coordonnées de texture
-    
-    Vertex() : position(), normal(), u(0.0f), v(0.0f) {}
-    Vertex(const Vector3D& pos) : position(pos), normal(), u(0.0f), v(0.0f) {}
-    Vertex(const Vector3D& pos, const Vector3D& norm, float u, float v) 
-        : position(pos), normal(norm), u(u), v(v) {}
+struct TexCoord {
+    float u, v;
 };
 
 /**
- * @struct Triangle
- * @brief Structure représentant un triangle (3 indices de vertices)
+ * @struct MeshData
+ * @brief Géométrie externe en lecture seule (tables constexpr, voir StaticSphere)
+ * 
+ * Un Mesh qui la référence n'alloue aucun flux.
  */
-struct Triangle {
-    int indices[3];  // Indices des 3 vertices
-    Vector3D normal; // Normale du triangle (calculée)
-    
-    Triangle() : indices{0, 0, 0}, normal() {}
-    Triangle(int i0, int i1, int i2) : indices{i0, i1, i2}, normal() {}
+struct MeshData {
+    const Vector3D* positions;
+    const Vector3D* normals;
+    const TexCoord* texCoords;
+    int vertexCount;
+    const Uint16* indices;          // Toujours sur 16 bits
+    int indexCount;
 };
 
 /**
  * @class Mesh
  * @brief Classe de base pour une géométrie 3D
+ * 
+ * Stockage en structure de tableaux (SoA) : positions, normales et
+ * coordonnées de texture sont des flux séparés, alignés sur 16 octets.
+ * La projection ne lit que les positions et les normales, sans charger
+ * le reste des sommets en cache.
+ * 
+ * Les indices (3 par triangle) sont sur 16 bits quand le mesh a au plus
+ * 65536 sommets (cas des sphères), sur 32 bits sinon.
+ * 
+ * Les flux sont soit générés (generate()), soit empruntés à un MeshData
+ * statique (setStaticData()).
  */
 class Mesh {
+public:
+    template <typename T>
+    using Stream = std::vector<T, AlignedAllocator<T>>;
+    
 protected:
-    std::vector<Vertex> vertices;    // Liste des sommets
-    std::vector<int> indices;        // Liste des indices (3 par triangle)
+    Stream<Vector3D> positions;     // Position 3D
+    Stream<Vector3D> normals;       // Normale (pour l'éclairage)
+    Stream<TexCoord> texCoords;     // Coordonnées de texture
+    
+    Stream<Uint16> shortIndices;    // Indices 16 bits (si assez peu de sommets)
+    Stream<Uint32> longIndices;     // Indices 32 bits sinon
+    
+    const MeshData* staticData;     // Géométrie empruntée (nullptr si générée)
+    
+    /**
+     * @brief Réserve les flux avant une série d'addVertex() / addTriangle()
+     */
+    void reserve(int vertexCount, int indexCount);
+    
+    /**
+     * @brief Ajoute un sommet
+     */
+    void addVertex(const Vector3D& position, const Vector3D& normal, float u, float v);
+    
+    /**
+     * @brief Ajoute un triangle (indices de sommets déjà ajoutés)
+     */
+    void addTriangle(Uint32 i0, Uint32 i1, Uint32 i2);
+    
+    /**
+     * @brief Passe les indices sur 16 bits si le nombre de sommets le permet
+     * 
+     * À appeler à la fin de generate() : addTriangle() remplit longIndices.
+     */
+    void compactIndices();
+    
+    /**
+     * @brief Emprunte une géométrie statique à la place des flux générés
+     * @param data Doit rester valide pendant toute la vie du mesh
+     */
+    void setStaticData(const MeshData* data);
     
 public:
     Mesh();
@@ -50,19 +97,36 @@ public:
     virtual void generate() = 0;
     
     /**
-     * @brief Calcule les normales des vertices
+     * @brief Calcule les normales des vertices (géométrie générée uniquement)
      */
     void calculateNormals();
     
     /**
-     * @brief Obtenir les vertices
+     * @brief Flux de sommets (getVertexCount() éléments chacun)
+     */
+    const Vector3D* getPositions() const { return staticData ? staticData->positions : positions.data(); }
+    const Vector3D* getNormals() const { return staticData ? staticData->normals : normals.data(); }
+    const TexCoord* getTexCoords() const { return staticData ? staticData->texCoords : texCoords.data(); }
+    int getVertexCount() const { return staticData ? staticData->vertexCount : (int)positions.size(); }
+    
+    /**
+     * @brief Indices sur 16 bits ? (sinon getLongIndices())
+     */
+    bool hasShortIndices() const { return staticData || !shortIndices.empty(); }
+    const Uint16* getShortIndices() const { return staticData ? staticData->indices : shortIndices.data(); }
+    const Uint32* getLongIndices() const { return longIndices.data(); }
+    
+    /**
+     * @brief Nombre d'indices (3 par triangle)
      */
-    const std::vector<Vertex>& getVertices() const;
+    int getIndexCount() const {
+        return staticData ? staticData->indexCount : (int)(shortIndices.size() + longIndices.size());
+    }
     
     /**
-     * @brief Obtenir les indices
+     * @brief Indice n (quel que soit le format)
      */
-    const std::vector<int>& getIndices() const;
+    Uint32 getIndex(int n) const { return hasShortIndices() ? getShortIndices()[n] : longIndices[n]; }
     
     /**
      * @brief Obtenir le nombre de triangles
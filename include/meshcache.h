@@ -0,0 +1,29 @@
+#ifndef MESHCACHE_H
+#define MESHCACHE_H
+
+#include "mesh.h"
+
+/**
+ * @file meshcache.h
+ * @brief Géométrie partagée par tous les corps célestes
+ *
+ * Une sphère unité par niveau de détail (Constants::LOD_SECTORS /
+ * LOD_STACKS), dont la géométrie est calculée à la compilation
+ * (voir staticsphere.h). Chaque corps
+ * applique son rayon par sa matrice model : la mémoire est en
+ * O(niveaux de LOD) et non plus en O(corps).
+ */
+namespace MeshCache {
+
+    /**
+     * @brief Sphère de rayon 1 du niveau de détail demandé
+     * @param level Niveau de LOD, borné à [0, LOD_LEVELS - 1]
+     * 
+     * Sans verrou une fois la construction faite : appelable depuis
+     * n'importe quel thread, le pointeur reste valide jusqu'à la fin du programme.
+     */
+    const Mesh* getUnitSphere(int level);
+
+} // namespace MeshCache
+
+#endif // MESHCACHE_H
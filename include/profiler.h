@@ -0,0 +1,95 @@
+#ifndef PROFILER_H
+#define PROFILER_H
+
+#include <SDL3/SDL.h>
+#include <atomic>
+#include <string>
+
+/**
+ * @file profiler.h
+ * @brief Chronométrage par étape de la frame, export au format Chrome trace
+ *
+ * PROFILE_SCOPE("nom") mesure la portée courante (horloge haute résolution)
+ * et l'enregistre dans un buffer circulaire propre au thread : aucun verrou
+ * sur le chemin chaud. exportChromeTrace() écrit les événements au format
+ * JSON de chrome://tracing et ui.perfetto.dev.
+ *
+ * Profilage désactivé (par défaut) : un seul test de booléen par portée.
+ * Compilé avec PROFILER_DISABLED : les macros ne génèrent aucun code.
+ */
+namespace Profiler {
+
+    /**
+     * @brief Active ou suspend l'enregistrement
+     */
+    void setEnabled(bool enabled);
+    
+    namespace Detail {
+        extern std::atomic<bool> enabled;
+    }
+    
+    inline bool isEnabled() {
+        return Detail::enabled.load(std::memory_order_relaxed);
+    }
+    
+    /**
+     * @brief Horloge monotone en nanosecondes
+     */
+    Uint64 now();
+    
+    /**
+     * @brief Enregistre un événement terminé dans le buffer du thread courant
+     * @param name Chaîne statique (seul le pointeur est conservé)
+     */
+    void record(const char* name, Uint64 startNs, Uint64 endNs);
+    
+    /**
+     * @brief Vide les buffers de tous les threads
+     */
+    void clear();
+    
+    /**
+     * @brief Écrit les événements enregistrés au format Chrome trace (JSON)
+     * 
+     * À appeler entre deux frames : les workers du rasterizer sont alors
+     * au repos et n'écrivent pas dans leurs buffers.
+     * @return false si le fichier n'a pas pu être écrit
+     */
+    bool exportChromeTrace(const std::string& path);
+    
+    /**
+     * @class ScopedTimer
+     * @brief Mesure la durée de vie de l'objet (utiliser PROFILE_SCOPE)
+     */
+    class ScopedTimer {
+    private:
+        const char* name;
+        Uint64 start;
+        
+    public:
+        explicit ScopedTimer(const char* name)
+            : name(name)
+            , start(isEnabled() ? now() : 0) {}
+        
+        ~ScopedTimer() {
+            if (start) {
+                record(name, start, now());
+            }
+        }
+        
+        ScopedTimer(const ScopedTimer&) = delete;
+        ScopedTimer& operator=(const ScopedTimer&) = delete;
+    };
+
+} // namespace Profiler
+
+#define PROFILE_CONCAT_INNER(a, b) a##b
+#define PROFILE_CONCAT(a, b) PROFILE_CONCAT_INNER(a, b)
+
+#ifdef PROFILER_DISABLED
+#define PROFILE_SCOPE(name) ((void)0)
+#else
+#define PROFILE_SCOPE(name) Profiler::ScopedTimer PROFILE_CONCAT(profileScope, __LINE__)(name)
+#endif
+
+#endif // PROFILER_H
@@ -2,10 +2,66 @@
 #define RASTERIZER_H
 
 #include <SDL3/SDL.h>
+#include <atomic>
 #include <vector>
-#include "Vector3D.h"
-#include "Matrix4x4.h"
-#include "Mesh.h"
+#include "vector3D.h"
+#include "matrix4x4.h"
+#include "mesh.h"
+#include "spankernels.h"
+#include "starsky.h"
+#include "threadpool.h"
+
+/**
+ * @enum RasterMode
+ * @brief Algorithme de remplissage des triangles
+ * 
+ * - SCANLINE : balayage ligne par ligne (historique)
+ * - TILED    : fonctions d'arête évaluées par tuiles de RASTER_TILE_SIZE pixels
+ */
+enum class RasterMode {
+    SCANLINE,
+    TILED
+};
+
+/**
+ * @enum DepthFormat
+ * @brief Format de stockage du Z-Buffer
+ * 
+ * La profondeur circule partout sous forme de "clé" flottante (plus petite
+ * = plus proche) ; seuls le stockage et l'effacement changent :
+ * - FLOAT32          : z NDC, 4 octets
+ * - FLOAT32_REVERSED : Z inversé (1 au plan proche, 0 au lointain) calculé
+ *                      depuis w, précis au loin ; stocké négatif, 4 octets
+ * - UNORM24          : [0, 1] sur 24 bits + 8 bits de génération, 4 octets,
+ *                      effacé en changeant de génération
+ * - UNORM16          : [0, 1] sur 16 bits, 2 octets
+ * Les formats sans génération n'effacent que les tuiles écrites à la frame
+ * précédente.
+ */
+enum class DepthFormat {
+    FLOAT32,
+    FLOAT32_REVERSED,
+    UNORM24,
+    UNORM16
+};
+
+/**
+ * @struct ScreenRect
+ * @brief Rectangle écran en pixels (bornes incluses)
+ */
+struct ScreenRect {
+    int x0, y0;
+    int x1, y1;
+};
+
+/**
+ * @struct SkyPixel
+ * @brief Étoile projetée à l'écran (voir Rasterizer::projectSky)
+ */
+struct SkyPixel {
+    int x, y;
+    Uint32 color;
+};
 
 /**
  * @class Rasterizer
@@ -17,15 +73,71 @@
  * - Backface culling
  * - Remplissage de triangles
  * - Éclairage diffuse
+ * 
+ * Tous les pixels sont écrits dans un framebuffer mémoire (ARGB8888),
+ * envoyé à l'écran en une seule fois par Renderer3D::present().
+ * 
+ * En mode tuilé, drawMesh() ne dessine pas directement : les triangles
+ * sont triés par tuiles d'écran (BIN_TILE_SIZE) puis flush() rasterise les
+ * tuiles en parallèle. Chaque tuile n'est traitée que par un seul thread,
+ * qui possède donc sa zone de couleur et de profondeur. Avec un seul
+ * thread le chemin est le même : rendu et compteurs de rejet identiques.
  */
 class Rasterizer {
 private:
-    SDL_Renderer* renderer;
     int width;
     int height;
     
-    // Z-Buffer pour gestion de profondeur
-    std::vector<float> zBuffer;
+    // Framebuffer couleur (ARGB8888, une ligne = width pixels)
+    std::vector<Uint32> colorBuffer;
+    Uint32 clearColor;
+    
+    // Zone de dessin autorisée (tout l'écran hors redessin partiel)
+    ScreenRect scissor;
+    
+    // Incrémenté à chaque réglage qui change l'image (mode, format, lumière...)
+    int settingsRevision;
+    
+    // Z-Buffer pour gestion de profondeur : un seul tableau alloué,
+    // selon le format courant
+    DepthFormat depthFormat;
+    std::vector<float> zBuffer;     // FLOAT32, FLOAT32_REVERSED
+    std::vector<Uint32> zBuffer24;  // UNORM24 : (génération << 24) | profondeur
+    std::vector<Uint16> zBuffer16;  // UNORM16
+    
+    // Génération UNORM24 : décroît à chaque frame pour que les valeurs des
+    // frames précédentes soient toujours plus loin ; vrai effacement au bouclage
+    Uint32 depthGeneration;
+    
+    // Plans proche et lointain de la caméra (pour le Z inversé)
+    float depthNear;
+    float depthFar;
+    
+    // Octets de Z-Buffer lus et écrits depuis le dernier clear()
+    std::atomic<Uint64> depthBytes;
+    
+    // Hierarchical Z : profondeur max par tuile, sur deux niveaux
+    // - niveau 0 : tuiles RASTER_TILE_SIZE (8x8)
+    // - niveau 1 : tuiles BIN_TILE_SIZE (64x64)
+    // Une écriture marque la tuile "sale" ; la valeur est recalculée à la
+    // prochaine lecture. Une valeur périmée reste un majorant : le rejet
+    // reste donc toujours correct.
+    int hiZColumns;
+    int hiZRows;
+    std::vector<float> hiZ0;
+    std::vector<float> hiZ1;
+    std::vector<Uint8> tileFlags;   // TILE_*, par tuile de niveau 0
+    std::vector<Uint8> hiZ1Dirty;
+    
+    enum TileFlag : Uint8 {
+        TILE_HIZ_DIRTY     = 1 << 0,  // hiZ0 à recalculer
+        TILE_DEPTH_WRITTEN = 1 << 1   // Profondeur écrite depuis le dernier effacement
+    };
+    
+    // Compteurs de rejets précoces (remis à zéro par clear())
+    std::atomic<int> earlyRejectedTiles;
+    int earlyRejectedTriangles;
+    int earlyRejectedBodies;
     
     // Éclairage
     Vector3D lightDirection;
@@ -35,38 +147,188 @@ private:
     // Mode wireframe
     bool wireframeMode;
     
+    // Corps dessinés en imposteurs analytiques plutôt qu'en triangles
+    bool impostorMode;
+    
+    // Algorithme de remplissage
+    RasterMode rasterMode;
+    
+    // Noyau de span (scalaire / SSE2 / AVX2, choisi selon le CPU)
+    SpanKernels::Level spanKernelLevel;
+    SpanKernels::DepthSpanFunc depthSpan;
+    SpanKernels::Unorm24SpanFunc depthSpan24;
+    SpanKernels::Unorm16SpanFunc depthSpan16;
+    
     /**
      * @brief Structure pour un vertex projeté
      */
     struct ProjectedVertex {
-        float x, y, z;  // Position écran + profondeur
+        Vector4D clip;  // Position clip space (avant division perspective)
+        float x, y, z;  // Position écran + profondeur (si devant la caméra)
         Vector3D normal;
-        float u, v;
-        bool visible;
+        int outcode;    // Plans de clipping violés (CLIP_*), 0 = visible
+    };
+    
+    /**
+     * @brief Bits d'outcode : plan proche et bords de la guard band
+     * 
+     * Seuls les triangles qui traversent un de ces plans sont clippés.
+     * Les triangles simplement hors écran (mais dans la guard band) sont
+     * rasterisés normalement, leur bounding box étant coupée à l'écran.
+     */
+    enum ClipPlane {
+        CLIP_NEAR   = 1 << 0,
+        CLIP_LEFT   = 1 << 1,
+        CLIP_RIGHT  = 1 << 2,
+        CLIP_BOTTOM = 1 << 3,
+        CLIP_TOP    = 1 << 4
     };
     
+    // Limites de la guard band en NDC (|x| <= guardBandX * w)
+    float guardBandX;
+    float guardBandY;
+    
+    /**
+     * @brief Triangle prêt à rasteriser (position écran + couleur éclairée)
+     */
+    struct RasterTriangle {
+        int fx[3], fy[3];         // Position écran en virgule fixe 28.4
+        float x[3], y[3], z[3];   // x, y : mêmes positions arrondies, en pixels
+        Uint32 pixel;
+    };
+    
+    // Points projetés de la polyligne en cours (réutilisé d'un appel à l'autre)
+    std::vector<ProjectedVertex> lineVertices;
+    
+    // Sommets du mesh en cours : sorties des transformations par lots,
+    // puis sommets projetés (réutilisés d'un appel à l'autre)
+    std::vector<Vector4D> clipPositions;
+    std::vector<Vector3D> worldNormals;
+    std::vector<ProjectedVertex> meshVertices;
+    
+    // Multithreading par tuiles
+    ThreadPool* threadPool;
+    int binColumns;
+    int binRows;
+    std::vector<RasterTriangle> binnedTriangles;
+    std::vector<std::vector<int>> bins;  // Indices dans binnedTriangles, par tuile
+    
+    /**
+     * @brief Recalcule la grille de tuiles après un redimensionnement
+     */
+    void resizeBins();
+    
+    /**
+     * @brief Ajoute un triangle aux tuiles qu'il recouvre
+     */
+    void binTriangle(const RasterTriangle& triangle);
+    
     /**
      * @brief Nettoie le Z-Buffer
+     * 
+     * UNORM24 : nouvelle génération (effacement complet une frame sur 255).
+     * Autres formats : seules les tuiles écrites depuis le dernier effacement.
      */
     void clearZBuffer();
     
     /**
-     * @brief Test de profondeur
+     * @brief Alloue le Z-Buffer du format courant et l'efface entièrement
      */
-    bool depthTest(int x, int y, float depth);
+    void allocateZBuffer();
     
     /**
-     * @brief Dessine une ligne (algorithme de Bresenham)
+     * @brief Clé de profondeur (format courant) d'un point en NDC
+     * @param ndcZ Profondeur NDC
+     * @param w Profondeur caméra (w clip space), utilisée par le Z inversé
      */
-    void drawLine(int x0, int y0, int x1, int y1, SDL_Color color);
+    float depthKey(float ndcZ, float w) const;
     
     /**
-     * @brief Remplit un triangle
+     * @brief Octets lus + écrits par pixel testé dans le Z-Buffer
      */
-    void fillTriangle(const ProjectedVertex& v0, 
-                     const ProjectedVertex& v1, 
-                     const ProjectedVertex& v2,
-                     SDL_Color baseColor);
+    int depthPixelBytes() const;
+    
+    /**
+     * @brief Alloue les niveaux du Hierarchical Z à la taille de l'écran
+     */
+    void resizeHiZ();
+    
+    /**
+     * @brief Profondeur max d'une tuile 8x8 (recalculée si sale)
+     */
+    float getTileMaxDepth(int tileX, int tileY);
+    
+    /**
+     * @brief Profondeur max d'une tuile 64x64 (recalculée si sale)
+     */
+    float getBlockMaxDepth(int blockX, int blockY);
+    
+    /**
+     * @brief Test de profondeur d'un pixel (écrit la profondeur si plus proche)
+     * @param depth Clé de profondeur (voir depthKey)
+     */
+    bool depthTest(int index, float depth);
+    
+    /**
+     * @brief Test de profondeur seul, sans écriture (lignes)
+     */
+    bool isDepthVisible(int index, float depth) const;
+    
+    /**
+     * @brief Clé de profondeur -> valeur stockée des formats entiers
+     */
+    Uint32 encodeUnorm24(float depth) const;
+    Uint16 encodeUnorm16(float depth) const;
+    
+    /**
+     * @brief Segment écran (coordonnées flottantes) : clipping Liang-Barsky
+     *        à la zone de dessin puis Bresenham, profondeur interpolée
+     * 
+     * Le point d'arrivée (x1, y1) n'est pas dessiné, quel que soit le sens :
+     * deux segments consécutifs ne dessinent leur sommet commun qu'une fois.
+     * @param depthTested Pixel écrit seulement s'il est devant le Z-Buffer
+     *        (le Z-Buffer n'est pas modifié)
+     */
+    void drawSegment(float x0, float y0, float z0,
+                     float x1, float y1, float z1,
+                     Uint32 pixel, bool depthTested);
+    
+    /**
+     * @brief Remplit un triangle ligne par ligne
+     * 
+     * Même couverture exacte que fillTriangleTiled (virgule fixe, règle
+     * top-left), sans découpage en tuiles.
+     */
+    void fillTriangle(const RasterTriangle& triangle);
+    
+    /**
+     * @brief Remplit un triangle par tuiles (fonctions d'arête incrémentales)
+     * 
+     * Les tuiles entièrement hors du triangle sont rejetées, celles
+     * entièrement dedans sont remplies sans test d'arête. La profondeur
+     * est interpolée par un gradient constant (plan z = f(x, y)).
+     * Les arêtes sont évaluées en entiers (28.4) avec la règle top-left :
+     * un pixel sur une arête partagée n'est dessiné qu'une seule fois.
+     */
+    void fillTriangleTiled(const RasterTriangle& triangle, const ScreenRect& clip);
+    
+    /**
+     * @brief Prépare un triangle (éclairage plat, coordonnées écran)
+     * 
+     * Les sommets sont arrondis au 1/16 de pixel : toute la couverture
+     * est ensuite calculée sur ces positions entières.
+     */
+    RasterTriangle setupTriangle(const ProjectedVertex& v0,
+                                 const ProjectedVertex& v1,
+                                 const ProjectedVertex& v2,
+                                 SDL_Color baseColor);
+    
+    /**
+     * @brief Écrit une portion de ligne [x0, x1] avec test de profondeur
+     * 
+     * Délègue au noyau SIMD sélectionné (voir SpanKernels).
+     */
+    void shadeSpan(int y, int x0, int x1, float z, float dzdx, Uint32 pixel);
     
     /**
      * @brief Calcule l'éclairage pour une normale
@@ -74,19 +336,88 @@ private:
     SDL_Color calculateLighting(const Vector3D& normal, SDL_Color baseColor);
     
     /**
-     * @brief Projette un vertex 3D en 2D
+     * @brief Outcode d'un point clip space
+     */
+    int computeOutcode(const Vector4D& clip) const;
+    
+    /**
+     * @brief Division perspective + viewport (remplit x, y, z)
+     */
+    void toScreen(ProjectedVertex& vertex) const;
+    
+    /**
+     * @brief Soumet les triangles indexés du mesh en cours (meshVertices)
+     * @param Index Uint16 ou Uint32 selon le format d'indices du mesh
+     */
+    template <typename Index>
+    void submitTriangles(const Index* indices, int indexCount, SDL_Color color, bool deferred);
+    
+    /**
+     * @brief Clippe un triangle en clip space (Sutherland-Hodgman) puis
+     *        soumet le polygone obtenu en éventail
+     * @param planes Plans à traiter (union des outcodes)
+     */
+    void clipAndSubmit(const ProjectedVertex& v0,
+                       const ProjectedVertex& v1,
+                       const ProjectedVertex& v2,
+                       int planes, SDL_Color color, bool deferred);
+    
+    /**
+     * @brief Backface culling, rejet Hierarchical Z puis remplissage
+     *        (sommets déjà devant la caméra et dans la guard band)
      */
-    ProjectedVertex projectVertex(const Vertex& vertex, const Matrix4x4& mvp);
+    void submitTriangle(const ProjectedVertex& p0,
+                        const ProjectedVertex& p1,
+                        const ProjectedVertex& p2,
+                        SDL_Color color, bool deferred);
     
 public:
-    Rasterizer(SDL_Renderer* renderer, int width, int height);
+    Rasterizer(int width, int height);
     ~Rasterizer();
     
+    /**
+     * @brief Convertit une couleur SDL en pixel ARGB8888
+     */
+    static Uint32 packColor(SDL_Color color) {
+        return ((Uint32)color.a << 24) | ((Uint32)color.r << 16) |
+               ((Uint32)color.g << 8) | (Uint32)color.b;
+    }
+    
     /**
      * @brief Nettoie l'écran et le z-buffer
      */
     void clear();
     
+    /**
+     * @brief Efface couleur et profondeur d'un rectangle seulement
+     */
+    void clearRect(const ScreenRect& rect);
+    
+    /**
+     * @brief Remet à zéro les compteurs de la frame (fait par clear())
+     */
+    void resetFrameStats();
+    
+    /**
+     * @brief Limite tout dessin (triangles, imposteurs, 2D) à un rectangle
+     * 
+     * Sert au redessin partiel : seule la zone effacée par clearRect()
+     * est redessinée, le reste du framebuffer est conservé.
+     */
+    void setScissor(const ScreenRect& rect);
+    void resetScissor();
+    const ScreenRect& getScissor() const { return scissor; }
+    
+    /**
+     * @brief Le rectangle touche-t-il la zone de dessin ?
+     */
+    bool intersectsScissor(const ScreenRect& rect) const;
+    
+    /**
+     * @brief Révision des réglages visibles (change si l'image doit être refaite)
+     */
+    int getSettingsRevision() const { return settingsRevision; }
+    
     /**
      * @brief Redimensionne le rasterizer
      */
@@ -99,6 +430,9 @@ public:
     
     /**
      * @brief Dessine un mesh complet
+     * 
+     * Lit directement les flux du mesh : positions et normales transformées
+     * par lots, indices 16 ou 32 bits.
      */
     void drawMesh(const Mesh* mesh,
                   const Matrix4x4& model,
@@ -106,20 +440,219 @@ public:
                   const Matrix4x4& projection,
                   SDL_Color color);
     
+    // ======================
+    // DESSIN 2D DANS LE FRAMEBUFFER
+    // ======================
+    
+    /**
+     * @brief Écrit un pixel (ignoré hors écran)
+     */
+    void setPixel(int x, int y, SDL_Color color);
+    
+    /**
+     * @brief Remplit un rectangle (mélange alpha si color.a < 255)
+     */
+    void fillRect(int x, int y, int w, int h, SDL_Color color);
+    
+    /**
+     * @brief Projette les étoiles visibles du ciel (une fois par frame)
+     * @param out Reçoit les étoiles qui tombent à l'écran
+     * 
+     * Seule la rotation de la vue compte (étoiles à l'infini). Les cellules
+     * du ciel hors du cône de vision sont ignorées en bloc.
+     */
+    void projectSky(const StarSky& sky, const Matrix4x4& view, const Matrix4x4& projection,
+                    std::vector<SkyPixel>& out) const;
+    
+    /**
+     * @brief Dessine les étoiles projetées (un pixel chacune, sans profondeur)
+     *        dans la zone de dessin courante
+     */
+    void drawSky(const std::vector<SkyPixel>& stars);
+    
+    /**
+     * @brief Dessine le contour d'un rectangle
+     */
+    void drawRect(int x, int y, int w, int h, SDL_Color color);
+    
+    /**
+     * @brief Écrit une image ARGB prémultipliée mélangée à un fond : src + fond * (1 - a)
+     * @param pixels w x h pixels, lignes consécutives
+     * @param background Fond de même taille (distinct du framebuffer)
+     */
+    void blendImage(int x, int y, int w, int h, const Uint32* pixels,
+                    const Uint32* background);
+    
+    /**
+     * @brief Dessine une ligne 2D (clippée à la zone de dessin, Bresenham)
+     */
+    void drawLine(int x0, int y0, int x1, int y1, SDL_Color color);
+    
+    /**
+     * @brief Dessine une ligne 3D
+     * 
+     * Clipping au plan proche en clip space, puis à l'écran ; avec
+     * depthTested, les parties cachées par les objets déjà dessinés
+     * (Z-Buffer) ne sont pas tracées.
+     */
+    void drawLine3D(const Vector3D& a, const Vector3D& b,
+                    const Matrix4x4& viewProjection,
+                    SDL_Color color, bool depthTested = true);
+    
+    /**
+     * @brief Dessine une polyligne 3D en un seul appel
+     * 
+     * Chaque point n'est transformé qu'une fois, les segments partagent
+     * leurs extrémités projetées.
+     * @param closed Relie aussi le dernier point au premier
+     */
+    void drawPolyline(const Vector3D* points, int count, bool closed,
+                      const Matrix4x4& viewProjection,
+                      SDL_Color color, bool depthTested = true);
+    
+    /**
+     * @brief Accès au framebuffer (pour l'upload vers la texture)
+     */
+    const Uint32* getColorBuffer() const { return colorBuffer.data(); }
+    int getWidth() const { return width; }
+    int getHeight() const { return height; }
+    
+    /**
+     * @brief Dessine une sphère par lancer de rayon analytique (imposteur)
+     * 
+     * Seuls les pixels du rectangle englobant la sphère à l'écran sont
+     * traités : intersection rayon/sphère, normale et profondeur exactes
+     * par pixel, écrites dans le Z-Buffer comme pour les triangles.
+     * Le coût dépend du nombre de pixels couverts, pas de la tessellation.
+     */
+    void drawSphereImpostor(const Vector3D& center, float radius,
+                            const Matrix4x4& view, const Matrix4x4& projection,
+                            SDL_Color color);
+    
+    /**
+     * @brief Teste si une zone est entièrement cachée par le Z-Buffer
+     * @param rect Zone écran couverte par l'objet
+     * @param minDepth Profondeur la plus proche de l'objet
+     * @return true si tout pixel de la zone est déjà plus proche que minDepth
+     */
+    bool isOccluded(const ScreenRect& rect, float minDepth);
+    
+    /**
+     * @brief Rectangle écran et profondeur minimale d'une sphère
+     * @param center Centre (repère monde)
+     * @param radius Rayon
+     * @return false si la sphère touche le plan proche (pas de borne fiable)
+     */
+    bool projectSphereBounds(const Vector3D& center, float radius,
+                             const Matrix4x4& view, const Matrix4x4& projection,
+                             ScreenRect& rect, float& minDepth) const;
+    
+    /**
+     * @brief Compte un corps entier rejeté avant drawMesh()
+     */
+    void countRejectedBody() { earlyRejectedBodies++; }
+    
+    /**
+     * @brief Rasterise les triangles en attente dans les tuiles (en parallèle)
+     * 
+     * À appeler après les drawMesh() d'une frame, avant de lire le framebuffer.
+     */
+    void flush();
+    
+    /**
+     * @brief flush() si des triangles en attente touchent les tuiles de rect
+     * 
+     * À appeler avant isOccluded() sur rect : le Z-Buffer y est alors le
+     * même qu'en rendu direct (un thread), donc les rejets aussi. Les objets
+     * sans recouvrement continuent de s'accumuler dans les tuiles.
+     */
+    void flushOverlapping(const ScreenRect& rect);
+    
+    /**
+     * @brief Nombre de threads de rasterisation (0 = nombre de coeurs)
+     * 
+     * Avec 1 thread, le mode tuilé passe par le même binning et le même
+     * flush() : seule la répartition des tuiles entre threads est sautée
+     * (mêmes pixels et mêmes compteurs de rejet qu'en parallèle).
+     */
+    void setThreadCount(int count);
+    int getThreadCount() const;
+    
     /**
      * @brief Toggle wireframe mode
      */
     void setWireframeMode(bool enabled);
     bool isWireframeMode() const;
     
+    /**
+     * @brief Toggle rendu des corps en imposteurs
+     */
+    void setImpostorMode(bool enabled);
+    bool isImpostorMode() const;
+    
+    /**
+     * @brief Choix de l'algorithme de remplissage (pour comparer les temps de frame)
+     */
+    void setRasterMode(RasterMode mode);
+    RasterMode getRasterMode() const;
+    
+    /**
+     * @brief Format du Z-Buffer (réalloué et effacé au changement)
+     */
+    void setDepthFormat(DepthFormat format);
+    DepthFormat getDepthFormat() const;
+    static const char* getDepthFormatName(DepthFormat format);
+    
+    /**
+     * @brief Plans proche et lointain de la caméra courante
+     */
+    void setDepthRange(float nearPlane, float farPlane);
+    
+    /**
+     * @brief Octets de Z-Buffer lus et écrits depuis le dernier clear()
+     * (effacement, tests de profondeur et Hierarchical Z)
+     */
+    Uint64 getDepthBytes() const;
+    
+    /**
+     * @brief Force un jeu d'instructions (limité à ce que supporte le CPU)
+     */
+    void setSpanKernelLevel(SpanKernels::Level level);
+    SpanKernels::Level getSpanKernelLevel() const;
+    
     /**
      * @brief Stats de rendu
      */
     int getLastTriangleCount() const;
     
+    /**
+     * @brief Triangles dessinés depuis le dernier clear() (tous les meshes)
+     */
+    int getFrameTriangleCount() const;
+    
+    /**
+     * @brief Triangles éliminés (face arrière ou hors champ) depuis le dernier clear()
+     */
+    int getFrameCulledTriangleCount() const;
+    
+    /**
+     * @brief Triangles du dernier mesh passés par le clipping (plan proche / guard band)
+     */
+    int getClippedTriangleCount() const;
+    
+    /**
+     * @brief Rejets précoces par le Hierarchical Z depuis le dernier clear()
+     */
+    int getEarlyRejectedTiles() const;
+    int getEarlyRejectedTriangles() const;
+    int getEarlyRejectedBodies() const;
+    
 private:
     int lastTriangleCount;
     int culledTriangleCount;
+    int clippedTriangleCount;
+    int frameTriangleCount;
+    int frameCulledTriangleCount;
 };
 
 #endif // RASTERIZER_H
\ No newline at end of file
@@ -3,10 +3,22 @@
 
 #include <SDL3/SDL.h>
 #include <vector>
-#include "Vector3D.h"
-#include "Rasterizer.h"
-#include "SolarSystem.h"
-#include "Camera.h"
+#include "vector3D.h"
+#include "rasterizer.h"
+#include "solarsystem.h"
+#include "camera.h"
+#include "starsky.h"
+#include "hud.h"
+
+/**
+ * @enum FrameRedraw
+ * @brief Ce que render() a redessiné à la dernière frame
+ */
+enum class FrameRedraw {
+    FULL,     // Tout l'écran
+    PARTIAL,  // Zones de getDirtyRects() seulement
+    NONE      // Rien n'a bougé : framebuffer de la frame précédente
+};
 
 /**
  * @class Renderer3D
@@ -17,6 +29,9 @@ private:
     SDL_Renderer* sdlRenderer;
     Rasterizer* rasterizer;
     
+    // Texture de streaming : reçoit le framebuffer du rasterizer à chaque frame
+    SDL_Texture* frameTexture;
+    
     int screenWidth;
     int screenHeight;
     
@@ -24,13 +39,27 @@ private:
     bool showStars;
     bool showInfo;
     
-    // Étoiles de fond
-    struct Star {
-        Vector3D position;
-        float brightness;
-        float size;
-    };
-    std::vector<Star> stars;
+    // Redessin incrémental : seules les zones où un corps a bougé sont
+    // effacées et redessinées, tant que la caméra et les réglages sont fixes
+    bool incrementalRedraw;
+    bool fullRedrawPending;             // Prochaine frame redessinée en entier
+    int lastSettingsRevision;           // Réglages du rasterizer à la dernière frame
+    Matrix4x4 lastViewProjection;
+    std::vector<Matrix4x4> lastBodyModels;
+    std::vector<ScreenRect> lastBodyRects;
+    std::vector<ScreenRect> dirtyRects; // Zones redessinées (redessin partiel)
+    FrameRedraw frameRedraw;            // Résultat de updateDirtyRects()
+    
+    // Étoiles de fond, précalculées et rangées par cellules de cube map
+    StarSky* starSky;
+    std::vector<SkyPixel> visibleStars;  // Projetées une fois par frame
+    
+    // Panneau de performances (calque mis en cache)
+    Hud* hud;
+    bool nominalTimings;     // Temps affichés déduits du FPS (images reproductibles)
+    Uint64 lastInfoTime;     // Instant du dernier renderInfo() (ns, 0 = aucun)
+    std::vector<Uint32> hudBackground;  // Scène sous le panneau (taille du panneau)
+    bool hudBackgroundValid;
     
     /**
      * @brief Génère les étoiles de fond
@@ -38,52 +67,120 @@ private:
     void generateStars();
     
     /**
-     * @brief Dessine les étoiles
+     * @brief (Re)crée la texture de streaming à la taille de l'écran
      */
-    void renderStars(Camera* camera);
+    void createFrameTexture();
     
     /**
-     * @brief Dessine un texte (pour debug/info)
+     * @brief Visibilité de la frame (étoiles, corps, orbites), une seule fois
+     * @param stageNs Temps par étape (Hud::Stage), complétés
      */
-    void drawText(const std::string& text, int x, int y);
+    void prepareScene(SolarSystem* solarSystem, Camera* camera, Uint64* stageNs);
+    
+    /**
+     * @brief Étoiles, corps puis orbites préparés (dans la zone de dessin courante)
+     * @param stageNs Temps par étape (Hud::Stage), complétés
+     */
+    void renderScene(SolarSystem* solarSystem, Uint64* stageNs);
+    
+    /**
+     * @brief Calcule les zones à redessiner depuis la frame précédente
+     * @return FULL si tout l'écran doit être redessiné, NONE si aucune zone
+     *         visible n'a changé
+     * 
+     * Zone d'un corps = union de son rectangle écran précédent et actuel,
+     * uniquement si sa matrice modèle a changé. Le panneau d'infos n'en
+     * fait pas partie : voir composeHud().
+     */
+    FrameRedraw updateDirtyRects(SolarSystem* solarSystem, Camera* camera);
+    
+    /**
+     * @brief Mélange le calque du panneau au framebuffer
+     * @param layerChanged Le calque a été redessiné depuis la frame précédente
+     * 
+     * La scène sous le panneau est mémorisée (copiée du framebuffer
+     * seulement là où elle vient d'être redessinée) : un calque inchangé
+     * n'est recomposé que dans ces zones, et un calque modifié est
+     * recomposé sur la scène mémorisée, sans redessiner la scène.
+     */
+    void composeHud(bool layerChanged);
     
 public:
+    /**
+     * @param renderer Renderer SDL de la fenêtre, ou nullptr en mode headless
+     *                 (rendu dans le framebuffer seul, present() sans effet)
+     */
     Renderer3D(SDL_Renderer* renderer, int width, int height);
     ~Renderer3D();
     
     /**
-     * @brief Nettoie l'écran
+     * @brief Nettoie l'écran (le prochain render() redessine tout)
+     * 
+     * Inutile avant render(), qui efface lui-même ce qu'il redessine.
      */
     void clear();
     
     /**
-     * @brief Présente le frame
+     * @brief Présente le frame (upload des seules zones redessinées, aucun
+     *        si rien n'a changé)
      */
     void present();
     
+    /**
+     * @brief Réaffiche la dernière frame envoyée, sans rendu ni upload
+     */
+    void presentCached();
+    
+    /**
+     * @brief La dernière frame rendue est-elle encore exacte ?
+     * 
+     * Compare caméra, réglages du rasterizer, matrices des corps et
+     * redessins demandés (toggles, taille) à l'état du dernier render().
+     */
+    bool isUpToDate(SolarSystem* solarSystem, Camera* camera) const;
+    
     /**
      * @brief Redimensionne
      */
     void resize(int width, int height);
     
     /**
-     * @brief Rendu complet du système solaire
+     * @brief Rendu du système solaire (complet ou limité aux zones modifiées)
      */
     void render(SolarSystem* solarSystem, Camera* camera);
     
     /**
-     * @brief Affiche les informations à l'écran
+     * @brief Affiche le panneau de performances (FPS, temps des étapes, triangles, courbe)
      */
     void renderInfo(int fps, int triangles, float simSpeed, CelestialBody* selectedBody);
     
     // Toggles
-    void toggleOrbits() { showOrbits = !showOrbits; }
-    void toggleStars() { showStars = !showStars; }
-    void toggleInfo() { showInfo = !showInfo; }
+    void toggleOrbits() { showOrbits = !showOrbits; fullRedrawPending = true; }
+    void toggleStars() { showStars = !showStars; fullRedrawPending = true; }
+    void toggleInfo() { showInfo = !showInfo; fullRedrawPending = true; }
+    void toggleIncrementalRedraw() { incrementalRedraw = !incrementalRedraw; fullRedrawPending = true; }
+    
+    /**
+     * @brief Régénère le ciel étoilé avec une graine fixe (images reproductibles)
+     */
+    void setStarSeed(unsigned int seed);
+    
+    /**
+     * @brief Panneau avec des temps nominaux (1000 / fps, étapes "--") au lieu
+     * des temps mesurés : le rendu ne dépend plus de la machine
+     */
+    void setNominalTimings(bool nominal) { nominalTimings = nominal; }
     
     bool areOrbitsVisible() const { return showOrbits; }
     bool areStarsVisible() const { return showStars; }
     bool isInfoVisible() const { return showInfo; }
+    bool isIncrementalRedraw() const { return incrementalRedraw; }
+    
+    /**
+     * @brief Zones redessinées à la dernière frame (si getFrameRedraw() == PARTIAL)
+     */
+    const std::vector<ScreenRect>& getDirtyRects() const { return dirtyRects; }
+    FrameRedraw getFrameRedraw() const { return frameRedraw; }
     
     Rasterizer* getRasterizer() { return rasterizer; }
 };
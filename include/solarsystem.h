@@ -2,9 +2,9 @@
 #define SOLARSYSTEM_H
 
 #include <vector>
-#include "CelestialBody.h"
-#include "Rasterizer.h"
-#include "Camera.h"
+#include "celestialbody.h"
+#include "rasterizer.h"
+#include "camera.h"
 
 /**
  * @class SolarSystem
@@ -15,6 +15,45 @@ private:
     std::vector<CelestialBody*> bodies;
     CelestialBody* sun;
     
+    // Corps hors du champ de vision lors du dernier prepareDraw()
+    int culledBodyCount;
+    
+    /**
+     * @brief Corps visible, préparé une fois par frame
+     */
+    struct BodyDraw {
+        CelestialBody* body;
+        Matrix4x4 model;
+        ScreenRect bounds;   // Valide si bounded
+        float minDepth;
+        bool bounded;        // false : corps contre le plan proche
+    };
+    
+    /**
+     * @brief Orbite visible, préparée une fois par frame
+     */
+    struct OrbitDraw {
+        int level;           // Cercle de orbitCircles
+        Matrix4x4 mvp;
+        ScreenRect bounds;
+        bool bounded;
+    };
+    
+    // Résultat de prepareDraw(), rejoué par draw() / drawOrbits()
+    Matrix4x4 drawView;
+    Matrix4x4 drawProjection;
+    std::vector<BodyDraw> visibleBodies;   // Du plus proche au plus lointain
+    std::vector<OrbitDraw> visibleOrbits;
+    
+    // Cercles unité du tracé des orbites, un par niveau de détail
+    // (Constants::ORBIT_LEVELS), calculés une fois pour tous les corps
+    std::vector<std::vector<Vector3D>> orbitCircles;
+    
+    /**
+     * @brief Niveau de cercle d'orbite d'après son rayon à l'écran
+     */
+    int selectOrbitLevel(float screenRadius) const;
+    
 public:
     SolarSystem();
     ~SolarSystem();
@@ -24,19 +63,38 @@ public:
      */
     void initialize();
     
+    /**
+     * @brief Ajoute un corps au système (qui en devient propriétaire)
+     */
+    void addBody(CelestialBody* body);
+    
     /**
      * @brief Met à jour tous les corps célestes
      */
     void update(float deltaTime);
     
     /**
-     * @brief Dessine le système complet
+     * @brief Visibilité de la frame : frustum culling, tri du plus proche au
+     *        plus lointain, niveaux de détail des corps et des orbites
+     * 
+     * Une seule fois par frame ; draw() et drawOrbits() rejouent ensuite le
+     * résultat dans chaque zone redessinée.
      */
-     void draw(Rasterizer* rasterizer, Camera* camera);
+    void prepareDraw(Rasterizer* rasterizer, Camera* camera);
+    
     /**
-     * @brief Dessine les orbites (SDL simple)
+     * @brief Dessine les corps préparés (dans la zone de dessin courante)
      */
-    void drawOrbits(SDL_Renderer* renderer, Camera* camera, int screenWidth, int screenHeight);
+    void draw(Rasterizer* rasterizer);
+    
+    /**
+     * @brief Dessine les orbites préparées dans le framebuffer du rasterizer
+     *
+     * À appeler après draw() : les orbites sont testées contre le Z-Buffer.
+     * Chaque orbite est une seule polyligne : le cercle unité partagé du
+     * niveau adapté à sa taille à l'écran, placé par getOrbitMatrix().
+     */
+    void drawOrbits(Rasterizer* rasterizer);
     
     /**
      * @brief Obtenir tous les corps
@@ -52,6 +110,11 @@ public:
      * @brief Obtenir le nombre total de triangles
      */
     int getTotalTriangleCount() const;
+    
+    /**
+     * @brief Nombre de corps éliminés par le frustum culling au dernier prepareDraw()
+     */
+    int getCulledBodyCount() const;
 };
 
 #endif // SOLARSYSTEM_H
\ No newline at end of file
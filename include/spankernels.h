@@ -0,0 +1,78 @@
+#ifndef SPANKERNELS_H
+#define SPANKERNELS_H
+
+#include <SDL3/SDL.h>
+
+/**
+ * @file spankernels.h
+ * @brief Noyaux de remplissage de spans (portions de ligne) pour le rasterizer
+ *
+ * Un span = count pixels consécutifs d'une ligne. Pour chaque pixel :
+ * - profondeur interpolée z + i * dzdx
+ * - test de profondeur contre le Z-Buffer
+ * - écriture masquée de la profondeur et de la couleur
+ *
+ * Trois implémentations (scalaire, SSE2 4 pixels, AVX2 8 pixels) choisies
+ * à l'exécution selon le CPU, pour qu'un même binaire tourne partout.
+ * Une variante par format de Z-Buffer : flottant, entier 24 bits tagué
+ * et entier 16 bits (voir DepthFormat dans rasterizer.h).
+ */
+namespace SpanKernels {
+
+    /**
+     * @brief Jeux d'instructions disponibles, du moins au plus rapide
+     */
+    enum class Level {
+        SCALAR,
+        SSE2,
+        AVX2
+    };
+
+    /**
+     * @brief Signature d'un noyau de span
+     * @param depth Z-Buffer à partir du premier pixel du span
+     * @param color Framebuffer à partir du premier pixel du span
+     * @param count Nombre de pixels
+     * @param z Profondeur au premier pixel
+     * @param dzdx Variation de profondeur par pixel
+     * @param pixel Couleur ARGB8888 à écrire
+     */
+    typedef void (*DepthSpanFunc)(float* depth, Uint32* color, int count,
+                                  float z, float dzdx, Uint32 pixel);
+
+    /**
+     * @brief Noyau de span pour un Z-Buffer entier 24 bits tagué
+     * @param depth Z-Buffer : (génération << 24) | profondeur 24 bits
+     * @param z Profondeur normalisée [0, 1] au premier pixel (saturée)
+     * @param tag Génération courante déjà décalée (génération << 24)
+     */
+    typedef void (*Unorm24SpanFunc)(Uint32* depth, Uint32* color, int count,
+                                    float z, float dzdx, Uint32 pixel, Uint32 tag);
+    
+    /**
+     * @brief Noyau de span pour un Z-Buffer entier 16 bits
+     * @param z Profondeur normalisée [0, 1] au premier pixel (saturée)
+     */
+    typedef void (*Unorm16SpanFunc)(Uint16* depth, Uint32* color, int count,
+                                    float z, float dzdx, Uint32 pixel);
+
+    /**
+     * @brief Meilleur niveau supporté par le CPU courant
+     */
+    Level detect();
+
+    /**
+     * @brief Noyau pour un niveau donné (retombe sur un niveau inférieur si non compilé)
+     */
+    DepthSpanFunc get(Level level);
+    Unorm24SpanFunc getUnorm24(Level level);
+    Unorm16SpanFunc getUnorm16(Level level);
+
+    /**
+     * @brief Nom lisible d'un niveau (pour les logs)
+     */
+    const char* getName(Level level);
+
+} // namespace SpanKernels
+
+#endif // SPANKERNELS_H
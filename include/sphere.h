@@ -1,11 +1,14 @@
 #ifndef SPHERE_H
 #define SPHERE_H
 
-#include "Mesh.h"
+#include "mesh.h"
 
 /**
  * @class Sphere
  * @brief Génère une sphère 3D par subdivision latitude/longitude
+ * 
+ * Chemin d'exécution pour un rayon et une tessellation quelconques ; les
+ * sphères unité des niveaux de LOD viennent de tables constexpr (StaticSphere).
  */
 // Correction d
 class Sphere : public Mesh {
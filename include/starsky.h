@@ -0,0 +1,96 @@
+#ifndef STARSKY_H
+#define STARSKY_H
+
+#include <SDL3/SDL.h>
+#include <vector>
+#include "vector3D.h"
+
+/**
+ * @class StarSky
+ * @brief Ciel étoilé précalculé, rangé dans une cube map
+ * 
+ * Les étoiles sont considérées à l'infini : seule la direction de vue
+ * compte. build() répartit le catalogue sur les texels des six faces
+ * d'une cube map (une seule étoile, la plus brillante, par texel) et
+ * regroupe les texels en cellules de SKY_CELL_SIZE de côté, chacune
+ * bornée par un cône. À chaque frame, seules les cellules dans le champ
+ * de vision sont projetées (Rasterizer::drawSky) : le coût est borné par
+ * la résolution de la cube map, quelle que soit la taille du catalogue.
+ */
+class StarSky {
+public:
+    /**
+     * @brief Groupe d'étoiles voisines sur une face
+     */
+    struct Cell {
+        Vector3D center;   // Direction de l'axe du cône (normalisée)
+        float cosRadius;   // Demi-angle du cône qui contient la cellule
+        float sinRadius;
+        int first;         // Premières étoiles dans directions / pixels
+        int count;
+    };
+    
+private:
+    int faceSize;       // Texels par côté de face
+    int cellsPerSide;   // Cellules par côté de face
+    
+    // Catalogue brut (addStar), traité par build()
+    std::vector<Vector3D> catalogDirections;
+    std::vector<float> catalogBrightness;
+    
+    // Étoiles retenues, groupées par cellule
+    std::vector<Cell> cells;
+    std::vector<Vector3D> directions;  // Normalisées
+    std::vector<Uint32> pixels;        // ARGB8888
+    
+    /**
+     * @brief Texel vu dans une direction (non normalisée, non nulle)
+     * @param cell Reçoit l'indice de la cellule du texel
+     */
+    int texelIndex(const Vector3D& direction, int& cell) const;
+    
+    /**
+     * @brief Direction d'un point (u, v) dans [-1, 1]² d'une face
+     */
+    static Vector3D faceDirection(int face, float u, float v);
+    
+public:
+    /**
+     * @brief Constructeur (ciel vide)
+     * @param faceSize Résolution d'une face (Constants::SKY_FACE_SIZE)
+     */
+    explicit StarSky(int faceSize);
+    
+    /**
+     * @brief Vide le catalogue et le ciel
+     */
+    void clear();
+    
+    /**
+     * @brief Ajoute une étoile au catalogue (visible après build())
+     * @param direction Direction depuis l'observateur (non nulle)
+     * @param brightness Luminosité [0, 1]
+     */
+    void addStar(const Vector3D& direction, float brightness);
+    
+    /**
+     * @brief Range le catalogue dans la cube map et calcule les cellules
+     */
+    void build();
+    
+    /**
+     * @brief Remplace le ciel par count étoiles uniformément réparties
+     */
+    void generate(int count, unsigned int seed);
+    
+    const std::vector<Cell>& getCells() const { return cells; }
+    const Vector3D* getDirections() const { return directions.data(); }
+    const Uint32* getPixels() const { return pixels.data(); }
+    
+    /**
+     * @brief Étoiles retenues (au plus une par texel)
+     */
+    int getStarCount() const { return (int)directions.size(); }
+};
+
+#endif // STARSKY_H
@@ -0,0 +1,181 @@
+#ifndef STATICSPHERE_H
+#define STATICSPHERE_H
+
+#include "mesh.h"
+#include "mathconstants.h"
+#include <array>
+
+/**
+ * @file staticsphere.h
+ * @brief Sphères unité dont la géométrie est calculée à la compilation
+ *
+ * SphereTables<Sectors, Stacks> produit en constexpr les mêmes sommets,
+ * normales, UV et indices que Sphere(1.0f, Sectors, Stacks) : les tables
+ * sont en données constantes du binaire, sans trigonométrie ni allocation
+ * au démarrage. Sphere reste le chemin d'exécution pour les tailles
+ * arbitraires.
+ */
+namespace ConstexprMath {
+    
+    constexpr double PI = 3.14159265358979323846;
+    
+    /**
+     * @brief Sinus par série de Taylor en double
+     * 
+     * x est ramené à [-π/2, π/2] par symétrie (sin(π - x) = sin(x)) : la
+     * série y converge sans cancellation, et les résultats arrondis en
+     * float coïncident avec std::sin, y compris près des multiples de π.
+     */
+    constexpr double sin(double x) {
+        while (x > PI) x -= 2.0 * PI;
+        while (x < -PI) x += 2.0 * PI;
+        if (x > PI / 2.0) x = PI - x;
+        if (x < -PI / 2.0) x = -PI - x;
+        
+        double term = x;
+        double sum = x;
+        for (int n = 1; n < 20; n++) {
+            term *= -x * x / ((2 * n) * (2 * n + 1));
+            sum += term;
+        }
+        return sum;
+    }
+    
+    constexpr double cos(double x) {
+        return sin(PI / 2.0 - x);
+    }
+    
+    /**
+     * @brief Racine carrée par Newton en double
+     */
+    constexpr double sqrt(double x) {
+        if (x <= 0.0) return 0.0;
+        double r = x > 1.0 ? x : 1.0;
+        for (int i = 0; i < 100; i++) {
+            double next = 0.5 * (r + x / r);
+            if (next == r) break;
+            r = next;
+        }
+        return r;
+    }
+
+} // namespace ConstexprMath
+
+/**
+ * @struct SphereTables
+ * @brief Géométrie constexpr d'une sphère unité (Sectors x Stacks)
+ *
+ * Même découpage et même arithmétique flottante que Sphere::generate().
+ */
+template <int Sectors, int Stacks>
+struct SphereTables {
+    static_assert(Sectors >= 3 && Stacks >= 2, "Tessellation trop faible");
+    
+    static constexpr int VERTEX_COUNT = (Sectors + 1) * (Stacks + 1);
+    static constexpr int INDEX_COUNT = 6 * Sectors * (Stacks - 1);
+    
+    static_assert(VERTEX_COUNT <= 65536, "Indices 16 bits : utiliser Sphere pour cette taille");
+    
+    static constexpr std::array<Vector3D, VERTEX_COUNT> makePositions() {
+        std::array<Vector3D, VERTEX_COUNT> out{};
+        const float sectorStep = Constants::TWO_PI / Sectors;
+        const float stackStep = Constants::PI / Stacks;
+        
+        // Trigonométrie par longitude, partagée par toutes les rangées
+        // (limite le coût de l'évaluation constexpr)
+        float sectorCos[Sectors + 1] = {};
+        float sectorSin[Sectors + 1] = {};
+        for (int j = 0; j <= Sectors; ++j) {
+            float sectorAngle = j * sectorStep;
+            sectorCos[j] = (float)ConstexprMath::cos(sectorAngle);
+            sectorSin[j] = (float)ConstexprMath::sin(sectorAngle);
+        }
+        
+        int k = 0;
+        for (int i = 0; i <= Stacks; ++i) {
+            float stackAngle = Constants::PI / 2.0f - i * stackStep;
+            float xy = (float)ConstexprMath::cos(stackAngle);
+            float z = (float)ConstexprMath::sin(stackAngle);
+            
+            for (int j = 0; j <= Sectors; ++j) {
+                out[k++] = Vector3D(xy * sectorCos[j], xy * sectorSin[j], z);
+            }
+        }
+        return out;
+    }
+    
+    static constexpr std::array<Vector3D, VERTEX_COUNT> makeNormals() {
+        std::array<Vector3D, VERTEX_COUNT> out = positions;
+        for (Vector3D& n : out) {
+            // Comme Vector3D::normalized() (jamais nul sur la sphère unité)
+            float len = (float)ConstexprMath::sqrt(n.lengthSquared());
+            n = Vector3D(n.x / len, n.y / len, n.z / len);
+        }
+        return out;
+    }
+    
+    static constexpr std::array<TexCoord, VERTEX_COUNT> makeTexCoords() {
+        std::array<TexCoord, VERTEX_COUNT> out{};
+        int k = 0;
+        for (int i = 0; i <= Stacks; ++i) {
+            for (int j = 0; j <= Sectors; ++j) {
+                out[k++] = TexCoord{(float)j / Sectors, (float)i / Stacks};
+            }
+        }
+        return out;
+    }
+    
+    static constexpr std::array<Uint16, INDEX_COUNT> makeIndices() {
+        std::array<Uint16, INDEX_COUNT> out{};
+        int n = 0;
+        for (int i = 0; i < Stacks; ++i) {
+            int k1 = i * (Sectors + 1);
+            int k2 = k1 + Sectors + 1;
+            
+            for (int j = 0; j < Sectors; ++j, ++k1, ++k2) {
+                if (i != 0) {
+                    out[n++] = (Uint16)k1;
+                    out[n++] = (Uint16)k2;
+                    out[n++] = (Uint16)(k1 + 1);
+                }
+                if (i != Stacks - 1) {
+                    out[n++] = (Uint16)(k1 + 1);
+                    out[n++] = (Uint16)k2;
+                    out[n++] = (Uint16)(k2 + 1);
+                }
+            }
+        }
+        return out;
+    }
+    
+    alignas(16) static constexpr std::array<Vector3D, VERTEX_COUNT> positions = makePositions();
+    alignas(16) static constexpr std::array<Vector3D, VERTEX_COUNT> normals = makeNormals();
+    alignas(16) static constexpr std::array<TexCoord, VERTEX_COUNT> texCoords = makeTexCoords();
+    alignas(16) static constexpr std::array<Uint16, INDEX_COUNT> indices = makeIndices();
+    
+    static constexpr MeshData data = {
+        positions.data(), normals.data(), texCoords.data(), VERTEX_COUNT,
+        indices.data(), INDEX_COUNT
+    };
+};
+
+/**
+ * @class StaticSphere
+ * @brief Sphère unité qui référence SphereTables<Sectors, Stacks> sans rien allouer
+ */
+template <int Sectors, int Stacks>
+class StaticSphere : public Mesh {
+public:
+    StaticSphere() {
+        setStaticData(&SphereTables<Sectors, Stacks>::data);
+    }
+    
+    /**
+     * @brief Rien à générer : la géométrie est dans les tables
+     */
+    void generate() override {
+        setStaticData(&SphereTables<Sectors, Stacks>::data);
+    }
+};
+
+#endif // STATICSPHERE_H
@@ -0,0 +1,70 @@
+#ifndef THREADPOOL_H
+#define THREADPOOL_H
+
+#include <atomic>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * @class ThreadPool
+ * @brief Pool de threads persistants pour les boucles parallèles du rendu
+ * 
+ * parallelFor() distribue des tâches numérotées [0, taskCount) entre les
+ * workers et le thread appelant, puis attend qu'elles soient toutes finies.
+ * Les threads restent en attente entre deux frames (pas de création par frame).
+ */
+class ThreadPool {
+private:
+    std::vector<std::thread> workers;
+    
+    std::mutex mutex;
+    std::condition_variable startCondition;
+    std::condition_variable doneCondition;
+    
+    // Travail en cours (valide seulement pendant parallelFor)
+    const std::function<void(int, int)>* job;
+    int taskCount;
+    std::atomic<int> nextTask;
+    int activeWorkers;
+    unsigned int generation;
+    bool stopping;
+    
+    /**
+     * @brief Boucle d'attente d'un worker
+     */
+    void workerLoop(int workerIndex);
+    
+    /**
+     * @brief Exécute des tâches jusqu'à épuisement
+     */
+    void runTasks(int workerIndex);
+    
+public:
+    /**
+     * @brief Constructeur
+     * @param threadCount Nombre total de threads, thread appelant inclus
+     */
+    explicit ThreadPool(int threadCount);
+    ~ThreadPool();
+    
+    ThreadPool(const ThreadPool&) = delete;
+    ThreadPool& operator=(const ThreadPool&) = delete;
+    
+    /**
+     * @brief Exécute job(task, worker) pour chaque tâche, de manière bloquante
+     * @param taskCount Nombre de tâches
+     * @param job Fonction appelée avec l'indice de tâche et l'indice du thread
+     *            (0 = thread appelant, < getThreadCount())
+     */
+    void parallelFor(int taskCount, const std::function<void(int task, int worker)>& job);
+    
+    /**
+     * @brief Nombre total de threads (thread appelant inclus)
+     */
+    int getThreadCount() const;
+};
+
+#endif // THREADPOOL_H
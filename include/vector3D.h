@@ -1,8 +1,11 @@
 #ifndef VECTOR3D_H
 #define VECTOR3D_H
 
+#include "mathconstants.h"
+#include <algorithm>
 #include <cmath>
-#include <iostream>
+#include <iosfwd>
+#include <type_traits>
 
 /**
  * @class Vector3D
@@ -13,6 +16,10 @@
  * - Directions et déplacements
  * - Normales pour l'éclairage
  * - Calculs géométriques
+ * 
+ * Les opérations sont définies dans ce header (inline / constexpr) : celles
+ * appelées dans les boucles du rasterizer sont inlinées partout, sans LTO.
+ * Seuls l'affichage et les avertissements sont dans vector3D.cpp.
  */
 class Vector3D {
 public:
@@ -21,24 +28,24 @@ public:
     // ======================
     // CONSTRUCTEURS
     // ======================
-    Vector3D();
-    Vector3D(float x, float y, float z);
+    constexpr Vector3D() noexcept;
+    constexpr Vector3D(float x, float y, float z) noexcept;
     
     // ======================
     // OPÉRATEURS ARITHMÉTIQUES
     // ======================
-    Vector3D operator+(const Vector3D& other) const;
-    Vector3D operator-(const Vector3D& other) const;
-    Vector3D operator*(float scalar) const;
+    constexpr Vector3D operator+(const Vector3D& other) const noexcept;
+    constexpr Vector3D operator-(const Vector3D& other) const noexcept;
+    constexpr Vector3D operator*(float scalar) const noexcept;
     Vector3D operator/(float scalar) const;
-    Vector3D operator-() const;  // Négation
+    constexpr Vector3D operator-() const noexcept;  // Négation
     
     // ======================
     // OPÉRATEURS D'AFFECTATION
     // ======================
-    Vector3D& operator+=(const Vector3D& other);
-    Vector3D& operator-=(const Vector3D& other);
-    Vector3D& operator*=(float scalar);
+    constexpr Vector3D& operator+=(const Vector3D& other) noexcept;
+    constexpr Vector3D& operator-=(const Vector3D& other) noexcept;
+    constexpr Vector3D& operator*=(float scalar) noexcept;
     Vector3D& operator/=(float scalar);
     
     // ======================
@@ -60,7 +67,7 @@ public:
      * - Projections
      * - Éclairage (cos de l'angle)
      */
-    float dot(const Vector3D& other) const;
+    constexpr float dot(const Vector3D& other) const noexcept;
     
     /**
      * @brief Produit vectoriel (cross product)
@@ -70,7 +77,7 @@ public:
      * - Calculer les normales des triangles
      * - Trouver un vecteur perpendiculaire
      */
-    Vector3D cross(const Vector3D& other) const;
+    constexpr Vector3D cross(const Vector3D& other) const noexcept;
     
     // ======================
     // LONGUEUR ET NORMALISATION
@@ -86,7 +93,7 @@ public:
      * @brief Calcule le carré de la longueur (plus rapide, pas de sqrt)
      * @return Longueur au carré
      */
-    float lengthSquared() const;
+    constexpr float lengthSquared() const noexcept;
     
     /**
      * @brief Retourne une copie normalisée (longueur = 1)
@@ -111,7 +118,7 @@ public:
     /**
      * @brief Distance au carré (plus rapide)
      */
-    float distanceSquared(const Vector3D& other) const;
+    constexpr float distanceSquared(const Vector3D& other) const noexcept;
     
     // ======================
     // INTERPOLATION
@@ -124,7 +131,7 @@ public:
      * @param t Facteur d'interpolation [0, 1]
      * @return Vecteur interpolé
      */
-    static Vector3D lerp(const Vector3D& a, const Vector3D& b, float t);
+    static constexpr Vector3D lerp(const Vector3D& a, const Vector3D& b, float t) noexcept;
     
     // ======================
     // UTILITAIRES
@@ -133,31 +140,211 @@ public:
     /**
      * @brief Modifie les composantes du vecteur
      */
-    void set(float x, float y, float z);
+    constexpr void set(float x, float y, float z) noexcept;
     
     /**
      * @brief Met toutes les composantes à zéro
      */
-    void setZero();
+    constexpr void setZero() noexcept;
     
     /**
      * @brief Affiche le vecteur (pour debug)
      */
     void print() const;
     
+    /**
+     * @brief Avertissement sur std::cerr, défini dans vector3D.cpp
+     * 
+     * Hors ligne : les cas dégénérés n'inlinent pas d'entrées/sorties dans
+     * les boucles qui utilisent Vector3D.
+     */
+    static void warn(const char* message);
+    
     // ======================
     // VECTEURS CONSTANTS UTILES
     // ======================
-    static Vector3D zero();      // (0, 0, 0)
-    static Vector3D one();       // (1, 1, 1)
-    static Vector3D up();        // (0, 1, 0)
-    static Vector3D down();      // (0, -1, 0)
-    static Vector3D left();      // (-1, 0, 0)
-    static Vector3D right();     // (1, 0, 0)
-    static Vector3D forward();   // (0, 0, 1)
-    static Vector3D back();      // (0, 0, -1)
+    static constexpr Vector3D zero() noexcept { return Vector3D(0.0f, 0.0f, 0.0f); }
+    static constexpr Vector3D one() noexcept { return Vector3D(1.0f, 1.0f, 1.0f); }
+    static constexpr Vector3D up() noexcept { return Vector3D(0.0f, 1.0f, 0.0f); }
+    static constexpr Vector3D down() noexcept { return Vector3D(0.0f, -1.0f, 0.0f); }
+    static constexpr Vector3D left() noexcept { return Vector3D(-1.0f, 0.0f, 0.0f); }
+    static constexpr Vector3D right() noexcept { return Vector3D(1.0f, 0.0f, 0.0f); }
+    static constexpr Vector3D forward() noexcept { return Vector3D(0.0f, 0.0f, 1.0f); }
+    static constexpr Vector3D back() noexcept { return Vector3D(0.0f, 0.0f, -1.0f); }
 };
 
+// ======================
+// CONSTRUCTEURS
+// ======================
+
+constexpr Vector3D::Vector3D() noexcept : x(0.0f), y(0.0f), z(0.0f) {}
+
+constexpr Vector3D::Vector3D(float x, float y, float z) noexcept : x(x), y(y), z(z) {}
+
+// ======================
+// OPÉRATEURS ARITHMÉTIQUES
+// ======================
+
+constexpr Vector3D Vector3D::operator+(const Vector3D& other) const noexcept {
+    return Vector3D(x + other.x, y + other.y, z + other.z);
+}
+
+constexpr Vector3D Vector3D::operator-(const Vector3D& other) const noexcept {
+    return Vector3D(x - other.x, y - other.y, z - other.z);
+}
+
+constexpr Vector3D Vector3D::operator*(float scalar) const noexcept {
+    return Vector3D(x * scalar, y * scalar, z * scalar);
+}
+
+inline Vector3D Vector3D::operator/(float scalar) const {
+    // Protection contre division par zéro
+    if (std::abs(scalar) < Constants::EPSILON) {
+        warn("Division by zero in Vector3D");
+        return Vector3D(0.0f, 0.0f, 0.0f);
+    }
+    return Vector3D(x / scalar, y / scalar, z / scalar);
+}
+
+constexpr Vector3D Vector3D::operator-() const noexcept {
+    return Vector3D(-x, -y, -z);
+}
+
+// ======================
+// OPÉRATEURS D'AFFECTATION
+// ======================
+
+constexpr Vector3D& Vector3D::operator+=(const Vector3D& other) noexcept {
+    x += other.x;
+    y += other.y;
+    z += other.z;
+    return *this;
+}
+
+constexpr Vector3D& Vector3D::operator-=(const Vector3D& other) noexcept {
+    x -= other.x;
+    y -= other.y;
+    z -= other.z;
+    return *this;
+}
+
+constexpr Vector3D& Vector3D::operator*=(float scalar) noexcept {
+    x *= scalar;
+    y *= scalar;
+    z *= scalar;
+    return *this;
+}
+
+inline Vector3D& Vector3D::operator/=(float scalar) {
+    if (std::abs(scalar) < Constants::EPSILON) {
+        warn("Division by zero in Vector3D");
+        return *this;
+    }
+    x /= scalar;
+    y /= scalar;
+    z /= scalar;
+    return *this;
+}
+
+// ======================
+// OPÉRATEURS DE COMPARAISON
+// ======================
+
+inline bool Vector3D::operator==(const Vector3D& other) const {
+    return std::abs(x - other.x) < Constants::EPSILON &&
+           std::abs(y - other.y) < Constants::EPSILON &&
+           std::abs(z - other.z) < Constants::EPSILON;
+}
+
+inline bool Vector3D::operator!=(const Vector3D& other) const {
+    return !(*this == other);
+}
+
+// ======================
+// PRODUITS VECTORIELS
+// ======================
+
+constexpr float Vector3D::dot(const Vector3D& other) const noexcept {
+    return x * other.x + y * other.y + z * other.z;
+}
+
+constexpr Vector3D Vector3D::cross(const Vector3D& other) const noexcept {
+    return Vector3D(
+        y * other.z - z * other.y,
+        z * other.x - x * other.z,
+        x * other.y - y * other.x
+    );
+}
+
+// ======================
+// LONGUEUR ET NORMALISATION
+// ======================
+
+inline float Vector3D::length() const {
+    return std::sqrt(x * x + y * y + z * z);
+}
+
+constexpr float Vector3D::lengthSquared() const noexcept {
+    return x * x + y * y + z * z;
+}
+
+inline Vector3D Vector3D::normalized() const {
+    float len = length();
+    if (len < Constants::EPSILON) {
+        warn("Normalizing zero-length vector");
+        return Vector3D(0.0f, 0.0f, 0.0f);
+    }
+    return *this / len;
+}
+
+inline void Vector3D::normalize() {
+    float len = length();
+    if (len < Constants::EPSILON) {
+        warn("Normalizing zero-length vector");
+        x = y = z = 0.0f;
+        return;
+    }
+    x /= len;
+    y /= len;
+    z /= len;
+}
+
+// ======================
+// DISTANCE
+// ======================
+
+inline float Vector3D::distance(const Vector3D& other) const {
+    return (*this - other).length();
+}
+
+constexpr float Vector3D::distanceSquared(const Vector3D& other) const noexcept {
+    return (*this - other).lengthSquared();
+}
+
+// ======================
+// INTERPOLATION
+// ======================
+
+constexpr Vector3D Vector3D::lerp(const Vector3D& a, const Vector3D& b, float t) noexcept {
+    // Clamp t entre 0 et 1
+    t = std::max(0.0f, std::min(1.0f, t));
+    return a + (b - a) * t;
+}
+
+// ======================
+// UTILITAIRES
+// ======================
+
+constexpr void Vector3D::set(float newX, float newY, float newZ) noexcept {
+    x = newX;
+    y = newY;
+    z = newZ;
+}
+
+constexpr void Vector3D::setZero() noexcept {
+    x = y = z = 0.0f;
+}
+
 // ======================
 // OPÉRATEURS EXTERNES
 // ======================
@@ -165,11 +352,15 @@ public:
 /**
  * @brief Permet d'écrire: 2.0f * vec
  */
-Vector3D operator*(float scalar, const Vector3D& vec);
+constexpr Vector3D operator*(float scalar, const Vector3D& vec) noexcept {
+    return vec * scalar;
+}
 
 /**
- * @brief Affichage avec std::cout
+ * @brief Affichage avec std::cout (défini dans vector3D.cpp)
  */
 std::ostream& operator<<(std::ostream& os, const Vector3D& vec);
 
+static_assert(std::is_trivially_copyable<Vector3D>::value, "Vector3D doit rester copiable par memcpy");
+
 #endif // VECTOR3D_H
\ No newline at end of file
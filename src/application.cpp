@@ -1,9 +1,10 @@
 #include <iostream>
 #include <SDL3/SDL.h>
-#include "Application.h"
+#include "application.h"
 #include "constants.h"
 #include "vector3D.h"
 #include "matrix4x4.h"
+#include "profiler.h"
 #include <iomanip>
 
 Application::Application()
@@ -15,6 +16,9 @@ Application::Application()
     , isRunning(false)
     , isPaused(false)
     , simulationSpeed(Constants::DEFAULT_SIMULATION_SPEED)
+    , skipUnchangedFrames(Constants::SKIP_UNCHANGED_FRAMES)
+    , frameDirty(true)
+    , presentPending(false)
     , lastFrameTime(0)
     , frameCount(0)
     , fpsTimer(0.0f)
@@ -76,6 +80,12 @@ bool Application::initializeComponents() {
     // Créer le renderer 3D
     renderer3D = new Renderer3D(renderer, screenWidth, screenHeight);
     std::cout << "[OK] Renderer 3D initialise" << std::endl;
+    std::cout << "    - Noyaux de span: "
+              << SpanKernels::getName(renderer3D->getRasterizer()->getSpanKernelLevel()) << std::endl;
+    std::cout << "    - Threads de rasterisation: "
+              << renderer3D->getRasterizer()->getThreadCount() << std::endl;
+    std::cout << "    - Z-Buffer: "
+              << Rasterizer::getDepthFormatName(renderer3D->getRasterizer()->getDepthFormat()) << std::endl;
     
     // Configurer la lumière
     renderer3D->getRasterizer()->setLightDirection(Vector3D(0.3f, -0.5f, 1.0f));
@@ -108,9 +118,14 @@ void Application::printControls() {
     std::cout << "\nCLAVIER :" << std::endl;
     std::cout << "  ESPACE    : Pause / Play" << std::endl;
     std::cout << "  W         : Toggle Wireframe" << std::endl;
+    std::cout << "  T         : Rasterizer tuiles / scanline" << std::endl;
+    std::cout << "  B         : Corps en imposteurs / triangles" << std::endl;
+    std::cout << "  Z         : Format du Z-Buffer (float / inverse / 24 / 16 bits)" << std::endl;
+    std::cout << "  D         : Redessin incremental (zones modifiees) on/off" << std::endl;
     std::cout << "  O         : Toggle Orbites" << std::endl;
     std::cout << "  S         : Toggle Etoiles" << std::endl;
     std::cout << "  I         : Toggle Info HUD" << std::endl;
+    std::cout << "  P         : Profilage on / off (ecrit " << Constants::PROFILE_TRACE_FILE << ")" << std::endl;
     std::cout << "  + / =     : Accelerer simulation" << std::endl;
     std::cout << "  -         : Ralentir simulation" << std::endl;
     std::cout << "  R         : Reset camera" << std::endl;
@@ -144,6 +159,13 @@ void Application::handleEvents() {
     SDL_Event event;
     
     while (SDL_PollEvent(&event)) {
+        // Toute entrée peut changer l'image (touches, souris, fenêtre)
+        if (event.type == SDL_EVENT_KEY_DOWN || event.type == SDL_EVENT_MOUSE_WHEEL ||
+            event.type == SDL_EVENT_WINDOW_RESIZED ||
+            (event.type == SDL_EVENT_MOUSE_MOTION && isDragging)) {
+            frameDirty = true;
+        }
+        
         switch (event.type) {
             case SDL_EVENT_QUIT:
                 isRunning = false;
@@ -168,6 +190,40 @@ void Application::handleEvents() {
                                     "[WIREFRAME ON]" : "[WIREFRAME OFF]") << std::endl;
                         break;
                     
+                    case SDLK_T: {
+                        Rasterizer* rasterizer = renderer3D->getRasterizer();
+                        rasterizer->setRasterMode(
+                            rasterizer->getRasterMode() == RasterMode::TILED ?
+                            RasterMode::SCANLINE : RasterMode::TILED
+                        );
+                        std::cout << (rasterizer->getRasterMode() == RasterMode::TILED ?
+                                    "[RASTER TUILES]" : "[RASTER SCANLINE]") << std::endl;
+                        break;
+                    }
+                    
+                    case SDLK_B:
+                        renderer3D->getRasterizer()->setImpostorMode(
+                            !renderer3D->getRasterizer()->isImpostorMode()
+                        );
+                        std::cout << (renderer3D->getRasterizer()->isImpostorMode() ?
+                                    "[IMPOSTEURS ON]" : "[IMPOSTEURS OFF]") << std::endl;
+                        break;
+                    
+                    case SDLK_Z: {
+                        Rasterizer* rasterizer = renderer3D->getRasterizer();
+                        int next = ((int)rasterizer->getDepthFormat() + 1) % 4;
+                        rasterizer->setDepthFormat((DepthFormat)next);
+                        std::cout << "[Z-BUFFER " << Rasterizer::getDepthFormatName(rasterizer->getDepthFormat())
+                                  << "]" << std::endl;
+                        break;
+                    }
+                    
+                    case SDLK_D:
+                        renderer3D->toggleIncrementalRedraw();
+                        std::cout << (renderer3D->isIncrementalRedraw() ?
+                                    "[REDESSIN INCREMENTAL ON]" : "[REDESSIN INCREMENTAL OFF]") << std::endl;
+                        break;
+                    
                     case SDLK_O:
                         renderer3D->toggleOrbits();
                         std::cout << (renderer3D->areOrbitsVisible() ? 
@@ -186,6 +242,21 @@ void Application::handleEvents() {
                                     "[INFO ON]" : "[INFO OFF]") << std::endl;
                         break;
                     
+                    case SDLK_P:
+                        if (!Profiler::isEnabled()) {
+                            Profiler::clear();
+                            Profiler::setEnabled(true);
+                            std::cout << "[PROFILAGE ON]" << std::endl;
+                        } else {
+                            Profiler::setEnabled(false);
+                            if (Profiler::exportChromeTrace(Constants::PROFILE_TRACE_FILE)) {
+                                std::cout << "[PROFILAGE OFF] Trace: " << Constants::PROFILE_TRACE_FILE << std::endl;
+                            } else {
+                                std::cerr << "[ERREUR] Ecriture trace: " << Constants::PROFILE_TRACE_FILE << std::endl;
+                            }
+                        }
+                        break;
+                    
                     case SDLK_EQUALS:
                     case SDLK_PLUS:
                         simulationSpeed += 0.2f;
@@ -280,11 +351,17 @@ void Application::handleEvents() {
                 camera->setAspectRatio((float)screenWidth / screenHeight);
                 std::cout << "[RESIZE] " << screenWidth << "x" << screenHeight << std::endl;
                 break;
+            
+            case SDL_EVENT_WINDOW_EXPOSED:
+                presentPending = true;
+                break;
         }
     }
 }
 
 void Application::update(float deltaTime) {
+    PROFILE_SCOPE("Application::update");
+    
     if (!isPaused) {
         solarSystem->update(deltaTime * simulationSpeed);
     }
@@ -293,10 +370,12 @@ void Application::update(float deltaTime) {
 }
 
 void Application::render() {
-    renderer3D->clear();
+    PROFILE_SCOPE("Application::render");
+    
+    // render() efface lui-même les zones qu'il redessine
     renderer3D->render(solarSystem, camera);
     renderer3D->renderInfo(currentFPS, 
-                          renderer3D->getRasterizer()->getLastTriangleCount(),
+                          renderer3D->getRasterizer()->getFrameTriangleCount(),
                           simulationSpeed,
                           selectedBody);
     renderer3D->present();
@@ -318,8 +397,28 @@ void Application::run() {
         // Mise à jour
         update(deltaTime);
         
+        // Rien de changé : la frame affichée est toujours exacte
+        bool changed = !skipUnchangedFrames || frameDirty || !isPaused ||
+                       !renderer3D->isUpToDate(solarSystem, camera);
+        frameDirty = false;
+        
+        if (!changed) {
+            if (presentPending) {
+                renderer3D->presentCached();
+                presentPending = false;
+            }
+            
+            // Dormir jusqu'au prochain événement ; le FPS ne mesure que les frames rendues
+            SDL_WaitEventTimeout(nullptr, Constants::IDLE_WAIT_MS);
+            lastFrameTime = SDL_GetTicks();
+            frameCount = 0;
+            fpsTimer = 0.0f;
+            continue;
+        }
+        
         // Rendu
         render();
+        presentPending = false;
         
         // FPS
         frameCount++;
@@ -329,9 +428,15 @@ void Application::run() {
             currentFPS = frameCount;
             
             std::cout << "FPS: " << std::setw(3) << currentFPS 
-                      << " | Triangles: " << std::setw(4) << renderer3D->getRasterizer()->getLastTriangleCount()
+                      << " | Triangles: " << std::setw(4) << renderer3D->getRasterizer()->getFrameTriangleCount()
                       << " | Vitesse: " << std::fixed << std::setprecision(1) << simulationSpeed << "x"
                       << " | Zoom: " << std::setw(3) << (int)camera->getDistance()
+                      << " | Hors champ: " << solarSystem->getCulledBodyCount()
+                      << " | HiZ rejets (corps/tri/tuiles): "
+                      << renderer3D->getRasterizer()->getEarlyRejectedBodies() << "/"
+                      << renderer3D->getRasterizer()->getEarlyRejectedTriangles() << "/"
+                      << renderer3D->getRasterizer()->getEarlyRejectedTiles()
+                      << " | Z-Buffer: " << renderer3D->getRasterizer()->getDepthBytes() / 1024 << " Ko"
                       << std::endl;
             
             frameCount = 0;
@@ -1,5 +1,5 @@
-#include "Camera.h"
-#include "Constants.h"
+#include "camera.h"
+#include "constants.h"
 #include <cmath>
 
 Camera::Camera(float aspectRatio, float fov)
@@ -48,6 +48,12 @@ void Camera::rotate(float deltaYaw, float deltaPitch) {
     update();
 }
 
+void Camera::setAngles(float newYaw, float newPitch) {
+    yaw = 0.0f;
+    pitch = 0.0f;
+    rotate(newYaw, newPitch);
+}
+
 void Camera::zoom(float delta) {
     distance += delta;
     
@@ -84,6 +90,30 @@ Matrix4x4 Camera::getViewProjectionMatrix() const {
     return projectionMatrix * viewMatrix;
 }
 
+Frustum Camera::getFrustum() const {
+    // Méthode de Gribb/Hartmann : chaque plan est une combinaison de lignes
+    // de la matrice vue-projection (clip = M * p)
+    Matrix4x4 m = getViewProjectionMatrix();
+    Frustum frustum;
+    
+    for (int i = 0; i < 6; i++) {
+        int row = i / 2;                      // x, y puis z
+        float sign = (i % 2 == 0) ? 1.0f : -1.0f;  // w + row, puis w - row
+        
+        Vector3D normal(m.at(3, 0) + sign * m.at(row, 0),
+                        m.at(3, 1) + sign * m.at(row, 1),
+                        m.at(3, 2) + sign * m.at(row, 2));
+        float d = m.at(3, 3) + sign * m.at(row, 3);
+        
+        // Normaliser pour obtenir de vraies distances
+        float length = normal.length();
+        frustum.planes[i].normal = normal / length;
+        frustum.planes[i].d = d / length;
+    }
+    
+    return frustum;
+}
+
 Vector3D Camera::getPosition() const {
     return position;
 }
@@ -96,6 +126,30 @@ float Camera::getDistance() const {
     return distance;
 }
 
+float Camera::getFov() const {
+    return fov;
+}
+
+float Camera::getNearPlane() const {
+    return nearPlane;
+}
+
+float Camera::getFarPlane() const {
+    return farPlane;
+}
+
+float Camera::getProjectedRadius(const Vector3D& center, float radius, int screenHeight) const {
+    float dist = position.distance(center);
+    
+    // Caméra dans la sphère : elle couvre tout l'écran
+    if (dist <= radius) {
+        return (float)screenHeight;
+    }
+    
+    float tanHalfFov = std::tan(fov * 0.5f * Constants::DEG_TO_RAD);
+    return radius / (dist * tanHalfFov) * (screenHeight * 0.5f);
+}
+
 void Camera::setAspectRatio(float ratio) {
     aspectRatio = ratio;
     updateMatrices();
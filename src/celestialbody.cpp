@@ -1,5 +1,6 @@
 #include "celestialbody.h"
 #include "constants.h"
+#include "meshcache.h"
 #include <cmath>
 
 CelestialBody::CelestialBody(const std::string& name,
@@ -17,14 +18,8 @@ CelestialBody::CelestialBody(const std::string& name,
     , currentAngle(0.0f)
     , currentRotation(0.0f)
     , color(color)
-    , isSun(isSun) {
-    
-    // Créer la géométrie
-    if (isSun) {
-        sphereMesh = new Sphere(visualRadius, Constants::SUN_SECTORS, Constants::SUN_STACKS);
-    } else {
-        sphereMesh = new Sphere(visualRadius, Constants::SPHERE_SECTORS, Constants::SPHERE_STACKS);
-    }
+    , isSun(isSun)
+    , currentLod(isSun ? Constants::SUN_DEFAULT_LOD : Constants::PLANET_DEFAULT_LOD) {
     
     // Position initiale
     position.x = std::cos(currentAngle) * orbitalRadius;
@@ -34,10 +29,6 @@ CelestialBody::CelestialBody(const std::string& name,
     rotation = Vector3D::zero();
 }
 
-CelestialBody::~CelestialBody() {
-    delete sphereMesh;
-}
-
 void CelestialBody::update(float deltaTime) {
     if (!isSun) {
         // 1. Mise à jour de l'angle orbital
@@ -58,13 +49,41 @@ Matrix4x4 CelestialBody::getModelMatrix() const {
     // Créer les matrices individuelles
     Matrix4x4 translation = Matrix4x4::translation(position.x, position.y, position.z);
     Matrix4x4 rotationMatrix = Matrix4x4::rotationY(rotation.y);
+    Matrix4x4 scaleMatrix = Matrix4x4::scale(visualRadius, visualRadius, visualRadius);
     
-    // L'ordre est crucial : Rotation d'abord (autour de l'origine locale), puis Translation
-    return translation * rotationMatrix;
+    // L'ordre est crucial : Échelle (sphère unité partagée), puis Rotation
+    // (autour de l'origine locale), puis Translation
+    return translation * rotationMatrix * scaleMatrix;
 }
 
-const Sphere* CelestialBody::getMesh() const {
-    return sphereMesh;
+Matrix4x4 CelestialBody::getOrbitMatrix() const {
+    // Orbite circulaire centrée sur le soleil, dans le plan XZ
+    return Matrix4x4::scale(orbitalRadius, orbitalRadius, orbitalRadius);
+}
+
+const Mesh* CelestialBody::getMesh() const {
+    return MeshCache::getUnitSphere(currentLod);
+}
+
+void CelestialBody::selectLod(float screenRadius) {
+    const float up = 1.0f + Constants::LOD_HYSTERESIS;
+    const float down = 1.0f - Constants::LOD_HYSTERESIS;
+    
+    // Monter en détail tant que le seuil du niveau courant est franchi
+    while (currentLod < Constants::LOD_LEVELS - 1 &&
+           screenRadius > Constants::LOD_SWITCH_RADIUS[currentLod] * up) {
+        currentLod++;
+    }
+    
+    // Descendre tant qu'on est nettement sous le seuil du niveau précédent
+    while (currentLod > 0 &&
+           screenRadius < Constants::LOD_SWITCH_RADIUS[currentLod - 1] * down) {
+        currentLod--;
+    }
+}
+
+int CelestialBody::getLodLevel() const {
+    return currentLod;
 }
 
 std::string CelestialBody::getName() const {
@@ -93,4 +112,9 @@ float CelestialBody::getCurrentAngle() const {
 
 float CelestialBody::getVisualRadius() const {
     return visualRadius;
+}
+
+float CelestialBody::getBoundingRadius() const {
+    // Sphère unité mise à l'échelle visualRadius par la matrice model
+    return visualRadius;
 }
\ No newline at end of file
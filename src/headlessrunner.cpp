@@ -0,0 +1,181 @@
+#include "headlessrunner.h"
+#include "renderer3D.h"
+#include "imagewriter.h"
+#include "constants.h"
+#include "profiler.h"
+#include <algorithm>
+#include <cstdio>
+#include <iomanip>
+#include <iostream>
+
+HeadlessOptions::HeadlessOptions()
+    : width(Constants::WINDOW_WIDTH)
+    , height(Constants::WINDOW_HEIGHT)
+    , frames(1)
+    , timeStep(Constants::FIXED_TIMESTEP)
+    , output("")
+    , outputEvery(1)
+    , starSeed(1)
+    , profile("")
+    , stars(false)
+    , orbits(true)
+    , info(true)
+    , wireframe(false)
+    , impostors(false) {}
+
+HeadlessRunner::HeadlessRunner(const HeadlessOptions& options)
+    : options(options) {}
+
+bool HeadlessRunner::expandOutputPattern(const std::string& pattern, int frame,
+                                         std::string& path, bool& numbered) {
+    path.clear();
+    numbered = false;
+    
+    for (size_t i = 0; i < pattern.size(); i++) {
+        if (pattern[i] != '%') {
+            path += pattern[i];
+            continue;
+        }
+        if (i + 1 < pattern.size() && pattern[i + 1] == '%') {
+            path += '%';
+            i++;
+            continue;
+        }
+        
+        // %d, %Nd (espaces) ou %0Nd (zéros), une seule fois
+        size_t j = i + 1;
+        char fill = ' ';
+        if (j < pattern.size() && pattern[j] == '0') {
+            fill = '0';
+            j++;
+        }
+        size_t width = 0;
+        while (j < pattern.size() && pattern[j] >= '0' && pattern[j] <= '9') {
+            width = width * 10 + (pattern[j] - '0');
+            if (width > 32) return false;
+            j++;
+        }
+        if (j >= pattern.size() || pattern[j] != 'd' || numbered) {
+            return false;
+        }
+        
+        std::string number = std::to_string(frame);
+        if (number.size() < width) {
+            path.append(width - number.size(), fill);
+        }
+        path += number;
+        numbered = true;
+        i = j;
+    }
+    return true;
+}
+
+std::string HeadlessRunner::outputPath(int frame) const {
+    if (options.output.empty()) return "";
+    
+    std::string path;
+    bool numbered;
+    if (!expandOutputPattern(options.output, frame, path, numbered)) return "";
+    
+    // Sans %d : seule la dernière frame est enregistrée
+    if (!numbered) {
+        return frame == options.frames - 1 ? path : "";
+    }
+    
+    if (frame % std::max(1, options.outputEvery) != 0 && frame != options.frames - 1) {
+        return "";
+    }
+    return path;
+}
+
+int HeadlessRunner::run() {
+    std::string firstPath;
+    bool numbered;
+    if (!expandOutputPattern(options.output, 0, firstPath, numbered)) {
+        std::cerr << "[ERREUR] Motif --output invalide (un seul %d, %Nd ou %0Nd ; %% pour '%'): "
+                  << options.output << std::endl;
+        return 1;
+    }
+    
+    std::cout << "=== Mode headless ===" << std::endl;
+    std::cout << "    - Resolution: " << options.width << "x" << options.height << std::endl;
+    std::cout << "    - Frames: " << options.frames
+              << " (pas " << options.timeStep << " s)" << std::endl;
+    
+    // Pas de SDL_Init(SDL_INIT_VIDEO) : ni fenêtre, ni renderer, ni texture
+    Renderer3D renderer3D(nullptr, options.width, options.height);
+    Rasterizer* rasterizer = renderer3D.getRasterizer();
+    rasterizer->setLightDirection(Vector3D(0.3f, -0.5f, 1.0f));
+    rasterizer->setWireframeMode(options.wireframe);
+    rasterizer->setImpostorMode(options.impostors);
+    renderer3D.setStarSeed(options.starSeed);
+    renderer3D.setNominalTimings(true);
+    if (options.stars != renderer3D.areStarsVisible()) renderer3D.toggleStars();
+    if (options.orbits != renderer3D.areOrbitsVisible()) renderer3D.toggleOrbits();
+    if (options.info != renderer3D.isInfoVisible()) renderer3D.toggleInfo();
+    
+    std::cout << "    - Noyaux de span: " << SpanKernels::getName(rasterizer->getSpanKernelLevel()) << std::endl;
+    std::cout << "    - Threads de rasterisation: " << rasterizer->getThreadCount() << std::endl;
+    
+    Camera camera((float)options.width / options.height, Constants::CAMERA_FOV);
+    SolarSystem solarSystem;
+    solarSystem.initialize();
+    
+    if (!options.profile.empty()) {
+        Profiler::clear();
+        Profiler::setEnabled(true);
+    }
+    
+    Uint64 frequency = SDL_GetPerformanceFrequency();
+    double totalMs = 0.0;
+    double minMs = 1e30;
+    double maxMs = 0.0;
+    int written = 0;
+    
+    for (int frame = 0; frame < options.frames; frame++) {
+        Uint64 start;
+        double ms;
+        {
+            PROFILE_SCOPE("Frame");
+            solarSystem.update(options.timeStep);
+            camera.update();
+            
+            start = SDL_GetPerformanceCounter();
+            renderer3D.render(&solarSystem, &camera);
+            // FPS nominal dans le HUD : les images ne dépendent pas de la machine
+            renderer3D.renderInfo(Constants::TARGET_FPS,
+                                  rasterizer->getFrameTriangleCount(),
+                                  Constants::DEFAULT_SIMULATION_SPEED,
+                                  solarSystem.getSun());
+            ms = (SDL_GetPerformanceCounter() - start) * 1000.0 / frequency;
+        }
+        
+        totalMs += ms;
+        minMs = std::min(minMs, ms);
+        maxMs = std::max(maxMs, ms);
+        
+        std::string path = outputPath(frame);
+        if (!path.empty()) {
+            if (!ImageWriter::write(path, rasterizer->getColorBuffer(), options.width, options.height)) {
+                std::cerr << "[ERREUR] Ecriture image: " << path << std::endl;
+                return 1;
+            }
+            written++;
+        }
+    }
+    
+    if (!options.profile.empty()) {
+        Profiler::setEnabled(false);
+        if (!Profiler::exportChromeTrace(options.profile)) {
+            std::cerr << "[ERREUR] Ecriture trace: " << options.profile << std::endl;
+            return 1;
+        }
+        std::cout << "[OK] Trace de profilage: " << options.profile << std::endl;
+    }
+    
+    std::cout << "[OK] " << options.frames << " frames rendues, " << written << " image(s) ecrite(s)" << std::endl;
+    std::cout << "    - Frame: moyenne " << std::fixed << std::setprecision(3)
+              << totalMs / std::max(1, options.frames) << " ms, min " << minMs
+              << " ms, max " << maxMs << " ms" << std::endl;
+    return 0;
+}
@@ -0,0 +1,173 @@
+#include "hud.h"
+#include "bitmapfont.h"
+#include "constants.h"
+#include <algorithm>
+#include <cmath>
+#include <cstdio>
+
+namespace {
+
+    constexpr int TEXT_LINES = 5;
+
+    // Couleurs ARGB prémultipliées
+    constexpr Uint32 BACKGROUND = 0xB4000000u;  // Noir, alpha 180
+    constexpr Uint32 BORDER = 0xFF00FF00u;
+    constexpr Uint32 TEXT = 0xFFE0E0E0u;
+    constexpr Uint32 BAR_OK = 0xFF00C800u;
+    constexpr Uint32 BAR_SLOW = 0xFFFFC800u;
+    constexpr Uint32 BAR_LATE = 0xFFFF3C3Cu;
+    constexpr Uint32 BUDGET_LINE = 0xFF808080u;
+
+    std::string format(const char* pattern, double a, double b) {
+        char buffer[64];
+        std::snprintf(buffer, sizeof(buffer), pattern, a, b);
+        return buffer;
+    }
+
+    std::string formatStages(const char* nameA, const char* nameB, double a, double b, bool known) {
+        char buffer[64];
+        if (known) {
+            std::snprintf(buffer, sizeof(buffer), "%-8s%5.2f   %-8s%5.2f", nameA, a, nameB, b);
+        } else {
+            std::snprintf(buffer, sizeof(buffer), "%-8s   --   %-8s   --", nameA, nameB);
+        }
+        return buffer;
+    }
+
+} // namespace
+
+Hud::Hud(int width, int height)
+    : width(width)
+    , height(height)
+    , layer(width * height, 0)
+    , windowFrames(0)
+    , windowFrameMs(0.0)
+    , historyHead(0)
+    , historyCount(0)
+    , layerValid(false)
+    , lines(TEXT_LINES)
+    , redrawCount(0) {
+    
+    std::fill(windowStageMs, windowStageMs + STAGE_COUNT, 0.0);
+    history.assign(std::max(1, width - 2 * Constants::HUD_PADDING), 0.0f);
+    bars.assign(history.size(), 0);
+}
+
+int Hud::getGraphTop() const {
+    return Constants::HUD_PADDING + TEXT_LINES * BitmapFont::LINE_HEIGHT + 3;
+}
+
+int Hud::getGraphHeight() const {
+    return std::max(0, height - getGraphTop() - Constants::HUD_PADDING);
+}
+
+void Hud::addStageTime(Stage stage, double ms) {
+    windowStageMs[stage] += ms;
+}
+
+void Hud::discardWindow() {
+    windowFrames = 0;
+    windowFrameMs = 0.0;
+    std::fill(windowStageMs, windowStageMs + STAGE_COUNT, 0.0);
+}
+
+bool Hud::endFrame(double frameMs, int fps, int triangles, int culledTriangles,
+                   float simSpeed, bool timingsMeasured) {
+    history[historyHead] = (float)frameMs;
+    historyHead = (historyHead + 1) % (int)history.size();
+    historyCount = std::min(historyCount + 1, (int)history.size());
+    
+    windowFrames++;
+    windowFrameMs += frameMs;
+    if (layerValid && windowFrames < Constants::HUD_REFRESH_FRAMES) return false;
+    
+    // Valeurs affichées : moyennes sur la fenêtre
+    double frames = windowFrames;
+    double* stages = windowStageMs;
+    std::vector<std::string> text(TEXT_LINES);
+    text[0] = format("FPS %.0f   FRAME %.1f MS", fps, windowFrameMs / frames);
+    text[1] = format("TRIANGLES %.0f   ELIMINES %.0f", triangles, culledTriangles);
+    text[2] = format("VITESSE %.1fX   BUDGET %.1f MS", simSpeed, 1000.0 / Constants::TARGET_FPS);
+    text[3] = formatStages("CIEL", "CORPS", stages[STAGE_STARS] / frames,
+                           stages[STAGE_BODIES] / frames, timingsMeasured);
+    text[4] = formatStages("ORBITES", "PRESENT", stages[STAGE_ORBITS] / frames,
+                           stages[STAGE_PRESENT] / frames, timingsMeasured);
+    discardWindow();
+    
+    // Courbe : la frame la plus récente à droite, échelle = deux fois le budget
+    float budgetMs = 1000.0f / Constants::TARGET_FPS;
+    int graphHeight = getGraphHeight();
+    int columns = (int)history.size();
+    std::vector<int> heights(columns, 0);
+    for (int i = 0; i < historyCount; i++) {
+        float ms = history[(historyHead - 1 - i + columns) % columns];
+        int h = (int)std::lround(ms / (2.0f * budgetMs) * graphHeight);
+        heights[columns - 1 - i] = std::min(std::max(h, 1), graphHeight);
+    }
+    
+    if (layerValid && text == lines && heights == bars) return false;
+    
+    lines.swap(text);
+    bars.swap(heights);
+    redraw(budgetMs);
+    return true;
+}
+
+void Hud::redraw(float budgetMs) {
+    const int pad = Constants::HUD_PADDING;
+    
+    std::fill(layer.begin(), layer.end(), BACKGROUND);
+    fillRect(0, 0, width, 1, BORDER);
+    fillRect(0, height - 1, width, 1, BORDER);
+    fillRect(0, 0, 1, height, BORDER);
+    fillRect(width - 1, 0, 1, height, BORDER);
+    
+    for (int i = 0; i < (int)lines.size(); i++) {
+        drawText(lines[i], pad, pad + i * BitmapFont::LINE_HEIGHT, TEXT);
+    }
+    
+    // Barres colorées selon le budget de la frame
+    int graphTop = getGraphTop();
+    int graphHeight = getGraphHeight();
+    int bottom = graphTop + graphHeight;
+    for (int i = 0; i < (int)bars.size(); i++) {
+        if (bars[i] == 0) continue;
+        
+        float ms = bars[i] * 2.0f * budgetMs / std::max(1, graphHeight);
+        Uint32 pixel = ms <= budgetMs ? BAR_OK : (ms <= 1.5f * budgetMs ? BAR_SLOW : BAR_LATE);
+        fillRect(pad + i, bottom - bars[i], 1, bars[i], pixel);
+    }
+    
+    // Ligne pointillée du budget (mi-hauteur)
+    int budgetY = bottom - graphHeight / 2;
+    for (int x = pad; x < pad + (int)bars.size(); x += 2) {
+        fillRect(x, budgetY, 1, 1, BUDGET_LINE);
+    }
+    
+    layerValid = true;
+    redrawCount++;
+}
+
+void Hud::fillRect(int x, int y, int w, int h, Uint32 pixel) {
+    int x0 = std::max(0, x);
+    int y0 = std::max(0, y);
+    int x1 = std::min(width, x + w);
+    int y1 = std::min(height, y + h);
+    for (int py = y0; py < y1; py++) {
+        std::fill(layer.begin() + py * width + x0, layer.begin() + py * width + x1, pixel);
+    }
+}
+
+void Hud::drawText(const std::string& text, int x, int y, Uint32 pixel) {
+    for (char c : text) {
+        const Uint8* glyph = BitmapFont::getGlyph(c);
+        for (int row = 0; row < BitmapFont::GLYPH_HEIGHT; row++) {
+            for (int col = 0; col < BitmapFont::GLYPH_WIDTH; col++) {
+                if (glyph[row] & (0x10 >> col)) {
+                    fillRect(x + col, y + row, 1, 1, pixel);
+                }
+            }
+        }
+        x += BitmapFont::ADVANCE;
+    }
+}
@@ -0,0 +1,143 @@
+#include "imagewriter.h"
+#include <algorithm>
+#include <cctype>
+#include <cstdio>
+#include <vector>
+
+namespace {
+
+// ======================
+// PNG : CRC32 ET ADLER32
+// ======================
+
+Uint32 crc32(const Uint8* data, size_t size, Uint32 crc = 0) {
+    static Uint32 table[256];
+    static bool tableReady = false;
+    if (!tableReady) {
+        for (Uint32 n = 0; n < 256; n++) {
+            Uint32 c = n;
+            for (int k = 0; k < 8; k++) {
+                c = (c & 1) ? 0xEDB88320u ^ (c >> 1) : c >> 1;
+            }
+            table[n] = c;
+        }
+        tableReady = true;
+    }
+    
+    crc = ~crc;
+    for (size_t i = 0; i < size; i++) {
+        crc = table[(crc ^ data[i]) & 0xFF] ^ (crc >> 8);
+    }
+    return ~crc;
+}
+
+void putBigEndian(std::vector<Uint8>& out, Uint32 value) {
+    out.push_back((Uint8)(value >> 24));
+    out.push_back((Uint8)(value >> 16));
+    out.push_back((Uint8)(value >> 8));
+    out.push_back((Uint8)value);
+}
+
+/**
+ * @brief Ajoute un chunk PNG : longueur, type, données, CRC(type + données)
+ */
+void putChunk(std::vector<Uint8>& out, const char* type, const std::vector<Uint8>& data) {
+    putBigEndian(out, (Uint32)data.size());
+    size_t start = out.size();
+    out.insert(out.end(), type, type + 4);
+    out.insert(out.end(), data.begin(), data.end());
+    putBigEndian(out, crc32(&out[start], out.size() - start));
+}
+
+bool writeFile(const std::string& path, const Uint8* data, size_t size) {
+    FILE* file = std::fopen(path.c_str(), "wb");
+    if (!file) return false;
+    bool ok = std::fwrite(data, 1, size, file) == size;
+    return std::fclose(file) == 0 && ok;
+}
+
+} // namespace
+
+namespace ImageWriter {
+
+bool writePPM(const std::string& path, const Uint32* pixels, int width, int height) {
+    char header[64];
+    int headerSize = std::snprintf(header, sizeof(header), "P6\n%d %d\n255\n", width, height);
+    
+    std::vector<Uint8> data(header, header + headerSize);
+    data.reserve(headerSize + (size_t)width * height * 3);
+    for (int i = 0; i < width * height; i++) {
+        data.push_back((Uint8)(pixels[i] >> 16));
+        data.push_back((Uint8)(pixels[i] >> 8));
+        data.push_back((Uint8)pixels[i]);
+    }
+    return writeFile(path, data.data(), data.size());
+}
+
+bool writePNG(const std::string& path, const Uint32* pixels, int width, int height) {
+    // Lignes brutes : octet de filtre (0 = aucun) puis RGB
+    std::vector<Uint8> raw;
+    raw.reserve((size_t)height * (1 + width * 3));
+    for (int y = 0; y < height; y++) {
+        raw.push_back(0);
+        for (int x = 0; x < width; x++) {
+            Uint32 p = pixels[y * width + x];
+            raw.push_back((Uint8)(p >> 16));
+            raw.push_back((Uint8)(p >> 8));
+            raw.push_back((Uint8)p);
+        }
+    }
+    
+    // Flux zlib : en-tête, blocs deflate non compressés (65535 octets max), Adler32
+    std::vector<Uint8> zlib = {0x78, 0x01};
+    const size_t BLOCK = 65535;
+    size_t offset = 0;
+    do {
+        size_t size = std::min(BLOCK, raw.size() - offset);
+        bool last = offset + size == raw.size();
+        zlib.push_back(last ? 1 : 0);
+        zlib.push_back((Uint8)size);
+        zlib.push_back((Uint8)(size >> 8));
+        zlib.push_back((Uint8)~size);
+        zlib.push_back((Uint8)(~size >> 8));
+        zlib.insert(zlib.end(), raw.begin() + offset, raw.begin() + offset + size);
+        offset += size;
+    } while (offset < raw.size());
+    
+    Uint32 a = 1, b = 0;
+    for (Uint8 byte : raw) {
+        a = (a + byte) % 65521;
+        b = (b + a) % 65521;
+    }
+    putBigEndian(zlib, (b << 16) | a);
+    
+    std::vector<Uint8> header;
+    putBigEndian(header, (Uint32)width);
+    putBigEndian(header, (Uint32)height);
+    header.push_back(8);  // Bits par composante
+    header.push_back(2);  // RGB
+    header.push_back(0);  // Compression deflate
+    header.push_back(0);  // Filtrage standard
+    header.push_back(0);  // Pas d'entrelacement
+    
+    std::vector<Uint8> png = {0x89, 'P', 'N', 'G', '\r', '\n', 0x1A, '\n'};
+    putChunk(png, "IHDR", header);
+    putChunk(png, "IDAT", zlib);
+    putChunk(png, "IEND", std::vector<Uint8>());
+    return writeFile(path, png.data(), png.size());
+}
+
+bool write(const std::string& path, const Uint32* pixels, int width, int height) {
+    size_t dot = path.find_last_of('.');
+    std::string extension = dot == std::string::npos ? "" : path.substr(dot);
+    for (char& c : extension) {
+        c = (char)std::tolower((unsigned char)c);
+    }
+    
+    if (extension == ".png") {
+        return writePNG(path, pixels, width, height);
+    }
+    return writePPM(path, pixels, width, height);
+}
+
+} // namespace ImageWriter
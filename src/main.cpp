@@ -1,7 +1,12 @@
-#include "Application.h"
+#include "application.h"
 #include <SDL3/SDL.h>
 #include "constants.h"
-#include "CelestialBody.h"
+#include "celestialbody.h"
+#include "headlessrunner.h"
+#include <algorithm>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
 #include <iostream>
 
 /**
@@ -14,9 +19,108 @@
  * - SDL3 uniquement (pas d'OpenGL)
  * - Software rasterizer 3D from scratch
  * - Pipeline graphique 3D complet implémenté manuellement
+ * 
+ * Sans argument : fenêtre interactive. Avec --headless : rendu sans
+ * fenêtre (serveurs, CI, mesures), voir printUsage().
+ */
+
+/**
+ * @brief Affiche les options de la ligne de commande
+ */
+static void printUsage(const char* program) {
+    std::cout << "Usage: " << program << " [options]\n"
+              << "\n"
+              << "  (aucune option)     Fenetre interactive\n"
+              << "  --headless          Rendu sans fenetre ni sous-systeme video\n"
+              << "\n"
+              << "Options du mode headless :\n"
+              << "  --size LxH          Resolution (defaut " << Constants::WINDOW_WIDTH
+              << "x" << Constants::WINDOW_HEIGHT << ")\n"
+              << "  --frames N          Nombre de frames (defaut 1)\n"
+              << "  --dt SECONDES       Pas de simulation par frame (defaut 1/" << Constants::TARGET_FPS << ")\n"
+              << "  --output FICHIER    Image .ppm ou .png de la derniere frame ;\n"
+              << "                      avec %d (ex. frame_%04d.png) : une image par frame\n"
+              << "  --every N           Avec %d : une image toutes les N frames\n"
+              << "  --seed N            Graine du ciel etoile (defaut 1)\n"
+              << "  --profile FICHIER   Trace Chrome/Perfetto des etapes de chaque frame\n"
+              << "  --stars             Afficher les etoiles\n"
+              << "  --no-orbits         Masquer les orbites\n"
+              << "  --no-hud            Masquer le HUD\n"
+              << "  --wireframe         Mode fil de fer\n"
+              << "  --impostors         Corps en imposteurs\n"
+              << "  --help              Cette aide" << std::endl;
+}
+
+/**
+ * @brief Lit les options du mode headless
+ * @return false si une option est inconnue ou mal formée
  */
+static bool parseHeadlessOptions(int argc, char* argv[], HeadlessOptions& options) {
+    for (int i = 1; i < argc; i++) {
+        const char* arg = argv[i];
+        bool hasValue = i + 1 < argc;
+        
+        if (std::strcmp(arg, "--headless") == 0) {
+            continue;
+        } else if (std::strcmp(arg, "--size") == 0 && hasValue) {
+            if (std::sscanf(argv[++i], "%dx%d", &options.width, &options.height) != 2 ||
+                options.width <= 0 || options.height <= 0) {
+                std::cerr << "[ERREUR] Resolution invalide: " << argv[i] << std::endl;
+                return false;
+            }
+        } else if (std::strcmp(arg, "--frames") == 0 && hasValue) {
+            options.frames = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--dt") == 0 && hasValue) {
+            options.timeStep = (float)std::atof(argv[++i]);
+        } else if (std::strcmp(arg, "--output") == 0 && hasValue) {
+            options.output = argv[++i];
+        } else if (std::strcmp(arg, "--every") == 0 && hasValue) {
+            options.outputEvery = std::max(1, std::atoi(argv[++i]));
+        } else if (std::strcmp(arg, "--seed") == 0 && hasValue) {
+            options.starSeed = (unsigned int)std::strtoul(argv[++i], nullptr, 10);
+        } else if (std::strcmp(arg, "--profile") == 0 && hasValue) {
+            options.profile = argv[++i];
+        } else if (std::strcmp(arg, "--stars") == 0) {
+            options.stars = true;
+        } else if (std::strcmp(arg, "--no-orbits") == 0) {
+            options.orbits = false;
+        } else if (std::strcmp(arg, "--no-hud") == 0) {
+            options.info = false;
+        } else if (std::strcmp(arg, "--wireframe") == 0) {
+            options.wireframe = true;
+        } else if (std::strcmp(arg, "--impostors") == 0) {
+            options.impostors = true;
+        } else {
+            std::cerr << "[ERREUR] Option inconnue ou incomplete: " << arg << std::endl;
+            return false;
+        }
+    }
+    return true;
+}
 
 int main(int argc, char* argv[]) {
+    bool headless = false;
+    for (int i = 1; i < argc; i++) {
+        if (std::strcmp(argv[i], "--help") == 0) {
+            printUsage(argv[0]);
+            return 0;
+        }
+        if (std::strcmp(argv[i], "--headless") == 0) {
+            headless = true;
+        }
+    }
+    
+    // Rendu sans fenêtre
+    if (headless) {
+        HeadlessOptions options;
+        if (!parseHeadlessOptions(argc, argv, options)) {
+            printUsage(argv[0]);
+            return 1;
+        }
+        HeadlessRunner runner(options);
+        return runner.run();
+    }
+    
     // Créer l'application
     Application app;
     
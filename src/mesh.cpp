@@ -1,33 +1,68 @@
-#include "Mesh.h"
+#include "mesh.h"
 #include <iostream>
 
-Mesh::Mesh() {}
+Mesh::Mesh() : staticData(nullptr) {}
 
 Mesh::~Mesh() {
     clear();
 }
 
+void Mesh::reserve(int vertexCount, int indexCount) {
+    positions.reserve(vertexCount);
+    normals.reserve(vertexCount);
+    texCoords.reserve(vertexCount);
+    longIndices.reserve(indexCount);
+}
+
+void Mesh::addVertex(const Vector3D& position, const Vector3D& normal, float u, float v) {
+    positions.push_back(position);
+    normals.push_back(normal);
+    texCoords.push_back(TexCoord{u, v});
+}
+
+void Mesh::addTriangle(Uint32 i0, Uint32 i1, Uint32 i2) {
+    longIndices.push_back(i0);
+    longIndices.push_back(i1);
+    longIndices.push_back(i2);
+}
+
+void Mesh::compactIndices() {
+    if (positions.size() > 65536 || longIndices.empty()) return;
+    
+    shortIndices.assign(longIndices.begin(), longIndices.end());
+    Stream<Uint32>().swap(longIndices);
+}
+
+void Mesh::setStaticData(const MeshData* data) {
+    clear();
+    staticData = data;
+}
+
 void Mesh::calculateNormals() {
+    if (staticData) return;  // Tables en lecture seule
+    
+    int vertexCount = getVertexCount();
+    
     // Réinitialiser toutes les normales à zéro
-    for (auto& vertex : vertices) {
-        vertex.normal = Vector3D::zero();
+    for (auto& normal : normals) {
+        normal = Vector3D::zero();
     }
     
     // Pour chaque triangle, calculer sa normale et l'ajouter aux vertices
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        int i0 = indices[i];
-        int i1 = indices[i + 1];
-        int i2 = indices[i + 2];
+    for (int i = 0; i + 2 < getIndexCount(); i += 3) {
+        int i0 = (int)getIndex(i);
+        int i1 = (int)getIndex(i + 1);
+        int i2 = (int)getIndex(i + 2);
         
         // Vérifier les indices valides
-        if (i0 >= (int)vertices.size() || i1 >= (int)vertices.size() || i2 >= (int)vertices.size()) {
+        if (i0 >= vertexCount || i1 >= vertexCount || i2 >= vertexCount) {
             continue;
         }
         
         // Récupérer les positions
-        const Vector3D& v0 = vertices[i0].position;
-        const Vector3D& v1 = vertices[i1].position;
-        const Vector3D& v2 = vertices[i2].position;
+        const Vector3D& v0 = positions[i0];
+        const Vector3D& v1 = positions[i1];
+        const Vector3D& v2 = positions[i2];
         
         // Calculer les edges
         Vector3D edge1 = v1 - v0;
@@ -37,37 +72,34 @@ void Mesh::calculateNormals() {
         Vector3D triangleNormal = edge1.cross(edge2);
         
         // Ajouter cette normale aux vertices du triangle
-        vertices[i0].normal += triangleNormal;
-        vertices[i1].normal += triangleNormal;
-        vertices[i2].normal += triangleNormal;
+        normals[i0] += triangleNormal;
+        normals[i1] += triangleNormal;
+        normals[i2] += triangleNormal;
     }
     
     // Normaliser toutes les normales
-    for (auto& vertex : vertices) {
-        vertex.normal.normalize();
+    for (auto& normal : normals) {
+        normal.normalize();
     }
 }
 
-const std::vector<Vertex>& Mesh::getVertices() const {
-    return vertices;
-}
-
-const std::vector<int>& Mesh::getIndices() const {
-    return indices;
-}
-
 int Mesh::getTriangleCount() const {
-    return indices.size() / 3;
+    return getIndexCount() / 3;
 }
 
 void Mesh::clear() {
-    vertices.clear();
-    indices.clear();
+    staticData = nullptr;
+    positions.clear();
+    normals.clear();
+    texCoords.clear();
+    shortIndices.clear();
+    longIndices.clear();
 }
 
 void Mesh::printStats() const {
     std::cout << "Mesh Stats:" << std::endl;
-    std::cout << "  Vertices: " << vertices.size() << std::endl;
+    std::cout << "  Vertices: " << getVertexCount() << std::endl;
     std::cout << "  Triangles: " << getTriangleCount() << std::endl;
-    std::cout << "  Indices: " << indices.size() << std::endl;
+    std::cout << "  Indices: " << getIndexCount()
+              << (hasShortIndices() ? " (16 bits)" : " (32 bits)") << std::endl;
 }
\ No newline at end of file
@@ -0,0 +1,47 @@
+#include "meshcache.h"
+#include "staticsphere.h"
+#include "constants.h"
+#include <tuple>
+#include <utility>
+
+namespace {
+
+template <typename Levels>
+struct SphereSet;
+
+/**
+ * @brief Chaîne de LOD complète : une StaticSphere par niveau
+ * 
+ * Les sphères ne font que référencer leurs tables constexpr : aucune
+ * trigonométrie ni allocation à la construction.
+ */
+template <std::size_t... Levels>
+struct SphereSet<std::index_sequence<Levels...>> {
+    std::tuple<StaticSphere<Constants::LOD_SECTORS[Levels], Constants::LOD_STACKS[Levels]>...> spheres;
+    const Mesh* levels[Constants::LOD_LEVELS];
+    
+    SphereSet() : levels{&std::get<Levels>(spheres)...} {}
+    
+    SphereSet(const SphereSet&) = delete;
+    SphereSet& operator=(const SphereSet&) = delete;
+};
+
+typedef SphereSet<std::make_index_sequence<Constants::LOD_LEVELS>> LodSpheres;
+
+const LodSpheres& spheres() {
+    // Initialisation thread-safe garantie par le langage (C++11)
+    static const LodSpheres set;
+    return set;
+}
+
+} // namespace
+
+namespace MeshCache {
+
+const Mesh* getUnitSphere(int level) {
+    if (level < 0) level = 0;
+    if (level >= Constants::LOD_LEVELS) level = Constants::LOD_LEVELS - 1;
+    return spheres().levels[level];
+}
+
+} // namespace MeshCache
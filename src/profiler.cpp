@@ -0,0 +1,137 @@
+#include "profiler.h"
+#include "constants.h"
+#include <algorithm>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <vector>
+
+namespace {
+
+struct Event {
+    const char* name;
+    Uint64 start;
+    Uint64 end;
+};
+
+/**
+ * @brief Buffer circulaire d'un thread : seul ce thread y écrit
+ */
+struct ThreadBuffer {
+    int threadId;
+    std::vector<Event> events;
+    std::atomic<Uint64> head;  // Nombre total d'événements écrits
+    
+    explicit ThreadBuffer(int id)
+        : threadId(id)
+        , events(Constants::PROFILER_RING_SIZE)
+        , head(0) {}
+};
+
+/**
+ * @brief Buffers de tous les threads, conservés après la fin du thread
+ *        (ceux d'un pool recréé restent exportables)
+ */
+struct Registry {
+    std::mutex mutex;
+    std::vector<ThreadBuffer*> buffers;
+    
+    ~Registry() {
+        for (ThreadBuffer* buffer : buffers) {
+            delete buffer;
+        }
+    }
+};
+
+Registry& registry() {
+    static Registry instance;
+    return instance;
+}
+
+ThreadBuffer* currentBuffer() {
+    // Enregistré au premier événement du thread (seul passage sous verrou)
+    thread_local ThreadBuffer* buffer = nullptr;
+    if (!buffer) {
+        Registry& reg = registry();
+        std::lock_guard<std::mutex> lock(reg.mutex);
+        buffer = new ThreadBuffer((int)reg.buffers.size());
+        reg.buffers.push_back(buffer);
+    }
+    return buffer;
+}
+
+} // namespace
+
+namespace Profiler {
+
+namespace Detail {
+    std::atomic<bool> enabled(false);
+}
+
+void setEnabled(bool enabled) {
+    Detail::enabled.store(enabled, std::memory_order_relaxed);
+}
+
+Uint64 now() {
+    return (Uint64)std::chrono::duration_cast<std::chrono::nanoseconds>(
+        std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+void record(const char* name, Uint64 startNs, Uint64 endNs) {
+    ThreadBuffer* buffer = currentBuffer();
+    Uint64 head = buffer->head.load(std::memory_order_relaxed);
+    buffer->events[head % buffer->events.size()] = Event{name, startNs, endNs};
+    buffer->head.store(head + 1, std::memory_order_release);
+}
+
+void clear() {
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    for (ThreadBuffer* buffer : reg.buffers) {
+        buffer->head.store(0, std::memory_order_release);
+    }
+}
+
+bool exportChromeTrace(const std::string& path) {
+    FILE* file = std::fopen(path.c_str(), "w");
+    if (!file) return false;
+    
+    Registry& reg = registry();
+    std::lock_guard<std::mutex> lock(reg.mutex);
+    
+    // Origine des temps : le plus ancien événement conservé
+    Uint64 origin = ~(Uint64)0;
+    for (ThreadBuffer* buffer : reg.buffers) {
+        Uint64 head = buffer->head.load(std::memory_order_acquire);
+        Uint64 size = buffer->events.size();
+        for (Uint64 i = head > size ? head - size : 0; i < head; i++) {
+            origin = std::min(origin, buffer->events[i % size].start);
+        }
+    }
+    
+    std::fprintf(file, "{\"displayTimeUnit\":\"ms\",\"traceEvents\":[\n");
+    bool first = true;
+    for (ThreadBuffer* buffer : reg.buffers) {
+        // Nom lisible de la piste du thread (numéroté par premier événement)
+        std::fprintf(file, "%s{\"name\":\"thread_name\",\"ph\":\"M\",\"pid\":1,\"tid\":%d,"
+                           "\"args\":{\"name\":\"Thread %d\"}}",
+                     first ? "" : ",\n", buffer->threadId, buffer->threadId);
+        first = false;
+        
+        // Événements complets ("X") : début et durée en microsecondes
+        Uint64 head = buffer->head.load(std::memory_order_acquire);
+        Uint64 size = buffer->events.size();
+        for (Uint64 i = head > size ? head - size : 0; i < head; i++) {
+            const Event& e = buffer->events[i % size];
+            std::fprintf(file, ",\n{\"name\":\"%s\",\"cat\":\"frame\",\"ph\":\"X\",\"pid\":1,\"tid\":%d,"
+                               "\"ts\":%.3f,\"dur\":%.3f}",
+                         e.name, buffer->threadId,
+                         (e.start - origin) / 1000.0, (e.end - e.start) / 1000.0);
+        }
+    }
+    std::fprintf(file, "\n]}\n");
+    
+    return std::fclose(file) == 0;
+}
+
+} // namespace Profiler
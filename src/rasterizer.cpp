@@ -1,59 +1,701 @@
-#include "Rasterizer.h"
+#include "rasterizer.h"
 #include "constants.h"
+#include "profiler.h"
 #include <algorithm>
 #include <cmath>
+#include <cstdint>
+#include <limits>
+#include <thread>
 
-Rasterizer::Rasterizer(SDL_Renderer* renderer, int width, int height)
-    : renderer(renderer)
-    , width(width)
+// ======================
+// VIRGULE FIXE 28.4
+// ======================
+
+namespace {
+
+const int SUBPIXEL = 1 << Constants::SUBPIXEL_BITS;
+const int HALF_PIXEL = SUBPIXEL / 2;
+
+/**
+ * @brief Fonctions d'arête d'un triangle en virgule fixe
+ * 
+ * E(x, y) est évaluée au centre des pixels, en entiers 64 bits (produits
+ * de coordonnées 28.4). Le biais de la règle top-left est déjà intégré :
+ * un pixel est couvert si et seulement si E >= 0 pour les trois arêtes.
+ */
+struct FixedEdges {
+    int64_t stepX[3];   // Variation de E d'un pixel vers la droite
+    int64_t stepY[3];   // Variation de E d'un pixel vers le bas
+    int64_t origin[3];  // E au centre du pixel (0, 0)
+    int minX, minY;     // Pixels dont le centre est dans la bounding box
+    int maxX, maxY;
+    
+    /**
+     * @brief Prépare les arêtes, false si le triangle est dégénéré ou de dos
+     */
+    bool setup(const int* fx, const int* fy) {
+        int64_t area = (int64_t)(fx[1] - fx[0]) * (fy[2] - fy[0]) -
+                       (int64_t)(fy[1] - fy[0]) * (fx[2] - fx[0]);
+        if (area <= 0) return false;
+        
+        // Arête i = arête opposée au sommet i
+        for (int i = 0; i < 3; i++) {
+            int a = (i + 1) % 3;
+            int b = (i + 2) % 3;
+            int64_t A = fy[a] - fy[b];
+            int64_t B = fx[b] - fx[a];
+            stepX[i] = A * SUBPIXEL;
+            stepY[i] = B * SUBPIXEL;
+            origin[i] = A * (HALF_PIXEL - fx[a]) + B * (HALF_PIXEL - fy[a]);
+            
+            // Arête gauche (descend à l'écran) ou du haut (horizontale vers la droite) :
+            // E == 0 est dedans, sinon dehors
+            bool topLeft = (A > 0) || (A == 0 && B > 0);
+            if (!topLeft) origin[i] -= 1;
+        }
+        
+        // Centres de pixels (x + 0.5) dans [min, max] : arrondis entiers exacts
+        minX = (std::min({fx[0], fx[1], fx[2]}) - HALF_PIXEL + SUBPIXEL - 1) >> Constants::SUBPIXEL_BITS;
+        maxX = (std::max({fx[0], fx[1], fx[2]}) - HALF_PIXEL) >> Constants::SUBPIXEL_BITS;
+        minY = (std::min({fy[0], fy[1], fy[2]}) - HALF_PIXEL + SUBPIXEL - 1) >> Constants::SUBPIXEL_BITS;
+        maxY = (std::max({fy[0], fy[1], fy[2]}) - HALF_PIXEL) >> Constants::SUBPIXEL_BITS;
+        return true;
+    }
+    
+    int64_t at(int i, int x, int y) const {
+        return origin[i] + stepX[i] * x + stepY[i] * y;
+    }
+    
+    /**
+     * @brief Intervalle couvert [first, last] de la ligne y entre x0 et x1
+     * 
+     * Un triangle étant convexe, chaque arête borne l'intervalle d'un côté.
+     * Retourne false si la ligne n'est pas couverte.
+     */
+    bool rowInterval(int y, int x0, int x1, int& first, int& last) const {
+        first = x0;
+        last = x1;
+        for (int i = 0; i < 3; i++) {
+            int64_t e = at(i, x0, y);
+            if (stepX[i] > 0) {
+                // e + stepX * k >= 0  <=>  k >= ceil(-e / stepX)
+                if (e < 0) {
+                    int64_t k = (-e + stepX[i] - 1) / stepX[i];
+                    if (k > x1 - x0) return false;
+                    first = std::max(first, x0 + (int)k);
+                }
+            } else if (stepX[i] < 0) {
+                // e + stepX * k >= 0  <=>  k <= floor(e / -stepX)
+                if (e < 0) return false;
+                int64_t k = e / -stepX[i];
+                if (k < x1 - x0) last = std::min(last, x0 + (int)k);
+            } else if (e < 0) {
+                return false;
+            }
+        }
+        return first <= last;
+    }
+};
+
+/**
+ * @brief Clipping Liang-Barsky d'un segment P(t) = P0 + t * D, t dans [0, 1]
+ * @return false si le segment est entièrement hors du rectangle ;
+ *         sinon [t0, t1] est la partie visible
+ */
+bool clipSegment(float x0, float y0, float dx, float dy,
+                 float minX, float minY, float maxX, float maxY,
+                 float& t0, float& t1) {
+    const float p[4] = {-dx, dx, -dy, dy};
+    const float q[4] = {x0 - minX, maxX - x0, y0 - minY, maxY - y0};
+    t0 = 0.0f;
+    t1 = 1.0f;
+    for (int i = 0; i < 4; i++) {
+        if (p[i] == 0.0f) {
+            // Parallèle au bord : dedans ou dehors en entier
+            if (q[i] < 0.0f) return false;
+        } else {
+            float r = q[i] / p[i];
+            if (p[i] < 0.0f) {
+                if (r > t1) return false;
+                t0 = std::max(t0, r);
+            } else {
+                if (r < t0) return false;
+                t1 = std::min(t1, r);
+            }
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+Rasterizer::Rasterizer(int width, int height)
+    : width(width)
     , height(height)
+    , clearColor(packColor(Constants::BACKGROUND_COLOR))
+    , scissor{0, 0, width - 1, height - 1}
+    , settingsRevision(0)
+    , depthFormat(DepthFormat::FLOAT32)
+    , depthGeneration(0)
+    , depthNear(Constants::CAMERA_NEAR)
+    , depthFar(Constants::CAMERA_FAR)
+    , depthBytes(0)
+    , hiZColumns(0)
+    , hiZRows(0)
+    , earlyRejectedTiles(0)
+    , earlyRejectedTriangles(0)
+    , earlyRejectedBodies(0)
     , lightDirection(0.0f, 0.0f, 1.0f)
     , lightColor{255, 255, 255, 255}
     , ambientStrength(Constants::AMBIENT_STRENGTH)
     , wireframeMode(false)
+    , impostorMode(false)
+    , rasterMode(RasterMode::TILED)
+    , spanKernelLevel(SpanKernels::detect())
+    , depthSpan(SpanKernels::get(spanKernelLevel))
+    , depthSpan24(SpanKernels::getUnorm24(spanKernelLevel))
+    , depthSpan16(SpanKernels::getUnorm16(spanKernelLevel))
+    , guardBandX(1.0f + 2.0f * Constants::GUARD_BAND_PIXELS / width)
+    , guardBandY(1.0f + 2.0f * Constants::GUARD_BAND_PIXELS / height)
+    , threadPool(nullptr)
+    , binColumns(0)
+    , binRows(0)
     , lastTriangleCount(0)
-    , culledTriangleCount(0) {
+    , culledTriangleCount(0)
+    , clippedTriangleCount(0)
+    , frameTriangleCount(0)
+    , frameCulledTriangleCount(0) {
     
-    zBuffer.resize(width * height, 1e10f);
+    colorBuffer.resize(width * height, clearColor);
     lightDirection.normalize();
+    
+    resizeBins();
+    resizeHiZ();
+    allocateZBuffer();
+    setThreadCount(Constants::RENDER_THREADS);
 }
 
 Rasterizer::~Rasterizer() {
+    delete threadPool;
+    colorBuffer.clear();
     zBuffer.clear();
+    zBuffer24.clear();
+    zBuffer16.clear();
+}
+
+void Rasterizer::allocateZBuffer() {
+    // Libérer les autres formats
+    std::vector<float>().swap(zBuffer);
+    std::vector<Uint32>().swap(zBuffer24);
+    std::vector<Uint16>().swap(zBuffer16);
+    
+    switch (depthFormat) {
+        case DepthFormat::UNORM24:
+            zBuffer24.assign(width * height, 0xFFFFFFFFu);
+            depthGeneration = 0xFE;
+            break;
+        case DepthFormat::UNORM16:
+            zBuffer16.assign(width * height, 0xFFFF);
+            break;
+        case DepthFormat::FLOAT32:
+        case DepthFormat::FLOAT32_REVERSED:
+            zBuffer.assign(width * height, 1e10f);
+            break;
+    }
+    
+    std::fill(hiZ0.begin(), hiZ0.end(), 1e10f);
+    std::fill(hiZ1.begin(), hiZ1.end(), 1e10f);
+    std::fill(tileFlags.begin(), tileFlags.end(), 0);
+    std::fill(hiZ1Dirty.begin(), hiZ1Dirty.end(), 0);
 }
 
 void Rasterizer::clearZBuffer() {
-    std::fill(zBuffer.begin(), zBuffer.end(), 1e10f);
+    const int T = Constants::RASTER_TILE_SIZE;
+    Uint64 bytes = 0;
+    
+    if (depthFormat == DepthFormat::UNORM24) {
+        // Nouvelle génération : les anciennes valeurs deviennent plus lointaines
+        // que toute nouvelle écriture, sans toucher à la mémoire
+        if (depthGeneration > 0) {
+            depthGeneration--;
+        } else {
+            std::fill(zBuffer24.begin(), zBuffer24.end(), 0xFFFFFFFFu);
+            depthGeneration = 0xFE;
+            bytes += zBuffer24.size() * sizeof(Uint32);
+        }
+    } else {
+        // Effacer uniquement les tuiles écrites, par plages de tuiles contiguës
+        for (int ty = 0; ty < hiZRows; ty++) {
+            const Uint8* flags = &tileFlags[ty * hiZColumns];
+            int tx = 0;
+            while (tx < hiZColumns) {
+                if (!(flags[tx] & TILE_DEPTH_WRITTEN)) {
+                    tx++;
+                    continue;
+                }
+                int runStart = tx;
+                while (tx < hiZColumns && (flags[tx] & TILE_DEPTH_WRITTEN)) {
+                    tx++;
+                }
+                
+                int x0 = runStart * T;
+                int count = std::min(width, tx * T) - x0;
+                int y1 = std::min(height, (ty + 1) * T);
+                for (int y = ty * T; y < y1; y++) {
+                    int index = y * width + x0;
+                    if (depthFormat == DepthFormat::UNORM16) {
+                        std::fill_n(&zBuffer16[index], count, (Uint16)0xFFFF);
+                    } else {
+                        std::fill_n(&zBuffer[index], count, 1e10f);
+                    }
+                }
+                bytes += (Uint64)count * (y1 - ty * T) * (depthPixelBytes() / 2);
+            }
+        }
+    }
+    
+    std::fill(hiZ0.begin(), hiZ0.end(), 1e10f);
+    std::fill(hiZ1.begin(), hiZ1.end(), 1e10f);
+    std::fill(tileFlags.begin(), tileFlags.end(), 0);
+    std::fill(hiZ1Dirty.begin(), hiZ1Dirty.end(), 0);
+    
+    depthBytes = bytes;
+}
+
+float Rasterizer::depthKey(float ndcZ, float w) const {
+    switch (depthFormat) {
+        case DepthFormat::FLOAT32_REVERSED:
+            // near * (far - w) / (w * (far - near)) : 1 au plan proche, 0 au lointain,
+            // la précision du flottant (proche de 0) va aux objets lointains
+            return -(depthNear * (depthFar - w)) / (w * (depthFar - depthNear));
+        case DepthFormat::UNORM24:
+        case DepthFormat::UNORM16:
+            return ndcZ * 0.5f + 0.5f;
+        case DepthFormat::FLOAT32:
+            break;
+    }
+    return ndcZ;
+}
+
+int Rasterizer::depthPixelBytes() const {
+    return depthFormat == DepthFormat::UNORM16 ? 2 * sizeof(Uint16) : 2 * sizeof(Uint32);
+}
+
+void Rasterizer::resizeHiZ() {
+    const int T = Constants::RASTER_TILE_SIZE;
+    hiZColumns = (width + T - 1) / T;
+    hiZRows = (height + T - 1) / T;
+    
+    hiZ0.assign(hiZColumns * hiZRows, 1e10f);
+    tileFlags.assign(hiZColumns * hiZRows, 0);
+    hiZ1.assign(binColumns * binRows, 1e10f);
+    hiZ1Dirty.assign(binColumns * binRows, 0);
+}
+
+float Rasterizer::getTileMaxDepth(int tileX, int tileY) {
+    int tile = tileY * hiZColumns + tileX;
+    if (tileFlags[tile] & TILE_HIZ_DIRTY) {
+        const int T = Constants::RASTER_TILE_SIZE;
+        int x0 = tileX * T;
+        int x1 = std::min(width, x0 + T);
+        int y0 = tileY * T;
+        int y1 = std::min(height, y0 + T);
+        
+        // Pas de borne initiale arbitraire : les clés FLOAT32_REVERSED sont
+        // dans [-1, 0] et celles de FLOAT32 négatives devant le milieu du volume
+        float maxDepth;
+        if (depthFormat == DepthFormat::UNORM24) {
+            // Une valeur d'une génération précédente compte comme vide
+            Uint32 maxValue = 0;
+            for (int y = y0; y < y1; y++) {
+                const Uint32* row = &zBuffer24[y * width];
+                for (int x = x0; x < x1; x++) {
+                    maxValue = std::max(maxValue, row[x]);
+                }
+            }
+            maxDepth = (maxValue >> 24) != depthGeneration ? 1e10f :
+                       (maxValue & 0xFFFFFF) * (1.0f / 16777215.0f);
+        } else if (depthFormat == DepthFormat::UNORM16) {
+            Uint16 maxValue = 0;
+            for (int y = y0; y < y1; y++) {
+                const Uint16* row = &zBuffer16[y * width];
+                for (int x = x0; x < x1; x++) {
+                    maxValue = std::max(maxValue, row[x]);
+                }
+            }
+            maxDepth = maxValue == 0xFFFF ? 1e10f : maxValue * (1.0f / 65535.0f);
+        } else {
+            maxDepth = zBuffer[y0 * width + x0];
+            for (int y = y0; y < y1; y++) {
+                const float* row = &zBuffer[y * width];
+                for (int x = x0; x < x1; x++) {
+                    maxDepth = std::max(maxDepth, row[x]);
+                }
+            }
+        }
+        hiZ0[tile] = maxDepth;
+        tileFlags[tile] &= ~TILE_HIZ_DIRTY;
+        depthBytes.fetch_add((Uint64)(x1 - x0) * (y1 - y0) * (depthPixelBytes() / 2),
+                             std::memory_order_relaxed);
+    }
+    return hiZ0[tile];
+}
+
+float Rasterizer::getBlockMaxDepth(int blockX, int blockY) {
+    int block = blockY * binColumns + blockX;
+    if (hiZ1Dirty[block]) {
+        const int ratio = Constants::BIN_TILE_SIZE / Constants::RASTER_TILE_SIZE;
+        int tx1 = std::min(hiZColumns, (blockX + 1) * ratio);
+        int ty1 = std::min(hiZRows, (blockY + 1) * ratio);
+        
+        float maxDepth = -std::numeric_limits<float>::max();
+        for (int ty = blockY * ratio; ty < ty1; ty++) {
+            for (int tx = blockX * ratio; tx < tx1; tx++) {
+                maxDepth = std::max(maxDepth, getTileMaxDepth(tx, ty));
+            }
+        }
+        hiZ1[block] = maxDepth;
+        hiZ1Dirty[block] = 0;
+    }
+    return hiZ1[block];
+}
+
+void Rasterizer::drawSphereImpostor(const Vector3D& center, float radius,
+                                    const Matrix4x4& view, const Matrix4x4& projection,
+                                    SDL_Color color) {
+    PROFILE_SCOPE("drawSphereImpostor");
+    
+    // Rectangle écran ; si la sphère touche le plan proche, tout l'écran
+    ScreenRect rect;
+    float minDepth;
+    if (!projectSphereBounds(center, radius, view, projection, rect, minDepth)) {
+        rect = {0, 0, width - 1, height - 1};
+    }
+    int x0 = std::max(scissor.x0, rect.x0);
+    int y0 = std::max(scissor.y0, rect.y0);
+    int x1 = std::min(scissor.x1, rect.x1);
+    int y1 = std::min(scissor.y1, rect.y1);
+    if (x0 > x1 || y0 > y1) return;
+    
+    // Sphère dans le repère caméra (origine = oeil, regard vers -Z)
+    Vector3D c = view.transformPoint(center);
+    float cc = c.dot(c) - radius * radius;
+    float invRadius = 1.0f / radius;
+    
+    // Termes de projection utiles
+    int tested = 0;
+    float p00 = projection.at(0, 0);
+    float p11 = projection.at(1, 1);
+    float p22 = projection.at(2, 2);
+    float p23 = projection.at(2, 3);
+    
+    const int T = Constants::RASTER_TILE_SIZE;
+    const int B = Constants::BIN_TILE_SIZE;
+    
+    for (int y = y0; y <= y1; y++) {
+        // Direction du rayon pour ce pixel : (ndcX / P00, ndcY / P11, -1)
+        float ndcY = 1.0f - (y + 0.5f) * 2.0f / height;
+        float dy = ndcY / p11;
+        int index = y * width + x0;
+        int firstWritten = -1;
+        int lastWritten = -1;
+        
+        for (int x = x0; x <= x1; x++, index++) {
+            float ndcX = (x + 0.5f) * 2.0f / width - 1.0f;
+            float dx = ndcX / p00;
+            
+            // |t * d - c|^2 = r^2  ->  a t^2 - 2 b t + cc = 0
+            float a = dx * dx + dy * dy + 1.0f;
+            float b = dx * c.x + dy * c.y - c.z;
+            float disc = b * b - a * cc;
+            if (disc < 0.0f) continue;
+            
+            // Intersection la plus proche entre les plans proche et lointain
+            // de la caméra (t est la distance le long de -Z, soit w)
+            float root = std::sqrt(disc);
+            float t = (b - root) / a;
+            if (t < depthNear) {
+                t = (b + root) / a;
+                if (t < depthNear) continue;
+            }
+            if (t > depthFar) continue;
+            
+            // Point touché (repère caméra) ; profondeur encodée comme pour
+            // les triangles (z NDC / w, puis depthKey selon le format)
+            float px = t * dx;
+            float py = t * dy;
+            float pz = -t;
+            tested++;
+            if (!depthTest(index, depthKey((p22 * pz + p23) / t, t))) continue;
+            
+            // Normale repère caméra -> monde (transposée de la rotation de vue)
+            float nx = (px - c.x) * invRadius;
+            float ny = (py - c.y) * invRadius;
+            float nz = (pz - c.z) * invRadius;
+            Vector3D normal(view.at(0, 0) * nx + view.at(1, 0) * ny + view.at(2, 0) * nz,
+                            view.at(0, 1) * nx + view.at(1, 1) * ny + view.at(2, 1) * nz,
+                            view.at(0, 2) * nx + view.at(1, 2) * ny + view.at(2, 2) * nz);
+            
+            colorBuffer[index] = packColor(calculateLighting(normal, color));
+            
+            if (firstWritten < 0) firstWritten = x;
+            lastWritten = x;
+        }
+        
+        // Marquer les tuiles du Hierarchical Z touchées
+        if (firstWritten >= 0) {
+            for (int tx = firstWritten / T; tx <= lastWritten / T; tx++) {
+                tileFlags[(y / T) * hiZColumns + tx] = TILE_HIZ_DIRTY | TILE_DEPTH_WRITTEN;
+            }
+            for (int bx = firstWritten / B; bx <= lastWritten / B; bx++) {
+                hiZ1Dirty[(y / B) * binColumns + bx] = 1;
+            }
+        }
+    }
+    
+    depthBytes += (Uint64)tested * depthPixelBytes();
+}
+
+bool Rasterizer::isOccluded(const ScreenRect& rect, float minDepth) {
+    int x0 = std::max(0, rect.x0);
+    int y0 = std::max(0, rect.y0);
+    int x1 = std::min(width - 1, rect.x1);
+    int y1 = std::min(height - 1, rect.y1);
+    if (x0 > x1 || y0 > y1) return false;
+    
+    // Niveau grossier d'abord : s'il suffit, pas besoin de descendre
+    const int B = Constants::BIN_TILE_SIZE;
+    bool coarseOccluded = true;
+    for (int by = y0 / B; by <= y1 / B && coarseOccluded; by++) {
+        for (int bx = x0 / B; bx <= x1 / B; bx++) {
+            if (minDepth <= getBlockMaxDepth(bx, by)) {
+                coarseOccluded = false;
+                break;
+            }
+        }
+    }
+    if (coarseOccluded) return true;
+    
+    // Niveau fin
+    const int T = Constants::RASTER_TILE_SIZE;
+    for (int ty = y0 / T; ty <= y1 / T; ty++) {
+        for (int tx = x0 / T; tx <= x1 / T; tx++) {
+            if (minDepth <= getTileMaxDepth(tx, ty)) {
+                return false;
+            }
+        }
+    }
+    return true;
+}
+
+bool Rasterizer::projectSphereBounds(const Vector3D& center, float radius,
+                                     const Matrix4x4& view, const Matrix4x4& projection,
+                                     ScreenRect& rect, float& minDepth) const {
+    // Centre dans le repère caméra (la caméra regarde vers -Z)
+    Vector3D c = view.transformPoint(center);
+    float nearestZ = c.z + radius;
+    if (-nearestZ <= depthNear) {
+        return false;
+    }
+    
+    // Projeter les 8 coins de la boîte englobante (entièrement devant la caméra)
+    float minX = 1e30f, maxX = -1e30f, minY = 1e30f, maxY = -1e30f;
+    for (int i = 0; i < 8; i++) {
+        Vector3D corner(c.x + ((i & 1) ? radius : -radius),
+                        c.y + ((i & 2) ? radius : -radius),
+                        c.z + ((i & 4) ? radius : -radius));
+        Vector3D p = projection.transformPoint(corner);
+        float sx = (p.x + 1.0f) * 0.5f * width;
+        float sy = (1.0f - p.y) * 0.5f * height;
+        minX = std::min(minX, sx);
+        maxX = std::max(maxX, sx);
+        minY = std::min(minY, sy);
+        maxY = std::max(maxY, sy);
+    }
+    
+    // Éviter les débordements d'entiers pour les sphères très proches
+    const float limit = 1e6f;
+    rect.x0 = (int)std::floor(std::max(minX, -limit));
+    rect.x1 = (int)std::ceil(std::min(maxX, limit));
+    rect.y0 = (int)std::floor(std::max(minY, -limit));
+    rect.y1 = (int)std::ceil(std::min(maxY, limit));
+    
+    // Profondeur du point le plus proche
+    minDepth = depthKey(projection.transformPoint(Vector3D(0.0f, 0.0f, nearestZ)).z, -nearestZ);
+    return true;
 }
 
 void Rasterizer::clear() {
+    // Abandonner les triangles d'une frame non terminée
+    binnedTriangles.clear();
+    for (auto& bin : bins) {
+        bin.clear();
+    }
+    
+    resetFrameStats();
     clearZBuffer();
-    SDL_SetRenderDrawColor(renderer, 0, 0, 0, 255);
-    SDL_RenderClear(renderer);
+    std::fill(colorBuffer.begin(), colorBuffer.end(), clearColor);
+}
+
+void Rasterizer::resetFrameStats() {
+    earlyRejectedTiles = 0;
+    earlyRejectedTriangles = 0;
+    earlyRejectedBodies = 0;
+    depthBytes = 0;
+    frameTriangleCount = 0;
+    frameCulledTriangleCount = 0;
+}
+
+void Rasterizer::clearRect(const ScreenRect& rect) {
+    int x0 = std::max(0, rect.x0);
+    int y0 = std::max(0, rect.y0);
+    int x1 = std::min(width - 1, rect.x1);
+    int y1 = std::min(height - 1, rect.y1);
+    if (x0 > x1 || y0 > y1) return;
+    
+    int count = x1 - x0 + 1;
+    for (int y = y0; y <= y1; y++) {
+        int index = y * width + x0;
+        std::fill_n(&colorBuffer[index], count, clearColor);
+        switch (depthFormat) {
+            case DepthFormat::UNORM24:
+                std::fill_n(&zBuffer24[index], count, 0xFFFFFFFFu);
+                break;
+            case DepthFormat::UNORM16:
+                std::fill_n(&zBuffer16[index], count, (Uint16)0xFFFF);
+                break;
+            case DepthFormat::FLOAT32:
+            case DepthFormat::FLOAT32_REVERSED:
+                std::fill_n(&zBuffer[index], count, 1e10f);
+                break;
+        }
+    }
+    depthBytes += (Uint64)count * (y1 - y0 + 1) * (depthPixelBytes() / 2);
+    
+    // Profondeur max des tuiles touchées à recalculer
+    const int T = Constants::RASTER_TILE_SIZE;
+    const int B = Constants::BIN_TILE_SIZE;
+    for (int ty = y0 / T; ty <= y1 / T; ty++) {
+        for (int tx = x0 / T; tx <= x1 / T; tx++) {
+            tileFlags[ty * hiZColumns + tx] = TILE_HIZ_DIRTY | TILE_DEPTH_WRITTEN;
+        }
+    }
+    for (int by = y0 / B; by <= y1 / B; by++) {
+        for (int bx = x0 / B; bx <= x1 / B; bx++) {
+            hiZ1Dirty[by * binColumns + bx] = 1;
+        }
+    }
+}
+
+void Rasterizer::setScissor(const ScreenRect& rect) {
+    scissor.x0 = std::max(0, rect.x0);
+    scissor.y0 = std::max(0, rect.y0);
+    scissor.x1 = std::min(width - 1, rect.x1);
+    scissor.y1 = std::min(height - 1, rect.y1);
+}
+
+void Rasterizer::resetScissor() {
+    scissor = {0, 0, width - 1, height - 1};
+}
+
+bool Rasterizer::intersectsScissor(const ScreenRect& rect) const {
+    return rect.x0 <= scissor.x1 && rect.x1 >= scissor.x0 &&
+           rect.y0 <= scissor.y1 && rect.y1 >= scissor.y0;
 }
 
 void Rasterizer::resize(int w, int h) {
     width = w;
     height = h;
-    zBuffer.resize(width * height, 1e10f);
+    guardBandX = 1.0f + 2.0f * Constants::GUARD_BAND_PIXELS / width;
+    guardBandY = 1.0f + 2.0f * Constants::GUARD_BAND_PIXELS / height;
+    colorBuffer.assign(width * height, clearColor);
+    resizeBins();
+    resizeHiZ();
+    allocateZBuffer();
+    resetScissor();
+    settingsRevision++;
 }
 
-bool Rasterizer::depthTest(int x, int y, float depth) {
-    if (x < 0 || x >= width || y < 0 || y >= height) {
-        return false;
+void Rasterizer::resizeBins() {
+    const int B = Constants::BIN_TILE_SIZE;
+    binColumns = (width + B - 1) / B;
+    binRows = (height + B - 1) / B;
+    
+    binnedTriangles.clear();
+    bins.assign(binColumns * binRows, std::vector<int>());
+}
+
+void Rasterizer::setThreadCount(int count) {
+    if (count <= 0) {
+        count = (int)std::thread::hardware_concurrency();
+        if (count <= 0) count = 1;
     }
     
-    int index = y * width + x;
-    if (depth < zBuffer[index]) {
-        zBuffer[index] = depth;
-        return true;
+    if (threadPool && threadPool->getThreadCount() == count) {
+        return;
     }
     
-    return false;
+    // Terminer le travail en attente avec l'ancien pool
+    flush();
+    delete threadPool;
+    threadPool = new ThreadPool(count);
+}
+
+int Rasterizer::getThreadCount() const {
+    return threadPool ? threadPool->getThreadCount() : 1;
+}
+
+bool Rasterizer::depthTest(int index, float depth) {
+    switch (depthFormat) {
+        case DepthFormat::UNORM24: {
+            Uint32 value = encodeUnorm24(depth);
+            if (value >= zBuffer24[index]) return false;
+            zBuffer24[index] = value;
+            return true;
+        }
+        case DepthFormat::UNORM16: {
+            Uint16 value = encodeUnorm16(depth);
+            if (value >= zBuffer16[index]) return false;
+            zBuffer16[index] = value;
+            return true;
+        }
+        case DepthFormat::FLOAT32:
+        case DepthFormat::FLOAT32_REVERSED:
+            break;
+    }
+    
+    if (depth >= zBuffer[index]) return false;
+    zBuffer[index] = depth;
+    return true;
+}
+
+bool Rasterizer::isDepthVisible(int index, float depth) const {
+    switch (depthFormat) {
+        case DepthFormat::UNORM24:
+            return encodeUnorm24(depth) < zBuffer24[index];
+        case DepthFormat::UNORM16:
+            return encodeUnorm16(depth) < zBuffer16[index];
+        case DepthFormat::FLOAT32:
+        case DepthFormat::FLOAT32_REVERSED:
+            break;
+    }
+    return depth < zBuffer[index];
+}
+
+Uint32 Rasterizer::encodeUnorm24(float depth) const {
+    // Même quantification que les noyaux de span
+    float q = std::min(std::max(depth, 0.0f) * 16777215.0f + 0.5f, 16777215.0f);
+    return (depthGeneration << 24) | (Uint32)q;
+}
+
+Uint16 Rasterizer::encodeUnorm16(float depth) const {
+    float q = std::min(std::max(depth, 0.0f) * 65535.0f + 0.5f, 65535.0f);
+    return (Uint16)q;
 }
 
 void Rasterizer::setLightDirection(const Vector3D& dir) {
     lightDirection = dir.normalized();
+    settingsRevision++;
 }
 
 SDL_Color Rasterizer::calculateLighting(const Vector3D& normal, SDL_Color baseColor) {
@@ -74,109 +716,519 @@ SDL_Color Rasterizer::calculateLighting(const Vector3D& normal, SDL_Color baseCo
     };
 }
 
-Rasterizer::ProjectedVertex Rasterizer::projectVertex(const Vertex& vertex, const Matrix4x4& mvp) {
-    ProjectedVertex result;
-    
-    // Transformer le point
-    Vector3D projected = mvp.transformPoint(vertex.position);
+int Rasterizer::computeOutcode(const Vector4D& clip) const {
+    int code = 0;
+    if (clip.z < -clip.w) code |= CLIP_NEAR;
+    if (clip.x < -guardBandX * clip.w) code |= CLIP_LEFT;
+    if (clip.x > guardBandX * clip.w) code |= CLIP_RIGHT;
+    if (clip.y < -guardBandY * clip.w) code |= CLIP_BOTTOM;
+    if (clip.y > guardBandY * clip.w) code |= CLIP_TOP;
+    return code;
+}
+
+void Rasterizer::toScreen(ProjectedVertex& vertex) const {
+    float invW = 1.0f / vertex.clip.w;
     
     // Convertir en coordonnées écran
-    result.x = (projected.x + 1.0f) * 0.5f * width;
-    result.y = (1.0f - projected.y) * 0.5f * height;
-    result.z = projected.z;
-    result.normal = vertex.normal;
-    result.u = vertex.u;
-    result.v = vertex.v;
-    result.visible = (result.x >= -100 && result.x <= width + 100 && 
-                     result.y >= -100 && result.y <= height + 100);
+    vertex.x = (vertex.clip.x * invW + 1.0f) * 0.5f * width;
+    vertex.y = (1.0f - vertex.clip.y * invW) * 0.5f * height;
+    vertex.z = depthKey(vertex.clip.z * invW, vertex.clip.w);
+}
+
+void Rasterizer::setPixel(int x, int y, SDL_Color color) {
+    if (x < scissor.x0 || x > scissor.x1 || y < scissor.y0 || y > scissor.y1) {
+        return;
+    }
+    colorBuffer[y * width + x] = packColor(color);
+}
+
+void Rasterizer::projectSky(const StarSky& sky, const Matrix4x4& view, const Matrix4x4& projection,
+                            std::vector<SkyPixel>& out) const {
+    out.clear();
+    
+    // Rotation de la vue seule, puis projection : lignes x, y et w du clip
+    // space pour une direction (w = 0, pas de translation)
+    Matrix4x4 rotation = view;
+    rotation.at(0, 3) = rotation.at(1, 3) = rotation.at(2, 3) = 0.0f;
+    Matrix4x4 m = projection * rotation;
+    
+    // Cône de vision : axe = direction regardée, ouverture = coin de l'écran
+    Vector3D forward(-view.at(2, 0), -view.at(2, 1), -view.at(2, 2));
+    float halfWidth = 1.0f / projection.at(0, 0);
+    float halfHeight = 1.0f / projection.at(1, 1);
+    float cosView = 1.0f / std::sqrt(1.0f + halfWidth * halfWidth + halfHeight * halfHeight);
+    float sinView = std::sqrt(1.0f - cosView * cosView);
+    
+    const Vector3D* directions = sky.getDirections();
+    const Uint32* pixels = sky.getPixels();
+    float halfW = 0.5f * width;
+    float halfH = 0.5f * height;
+    
+    for (const StarSky::Cell& cell : sky.getCells()) {
+        if (cell.count == 0) continue;
+        
+        // Cellule visible si les deux cônes se touchent :
+        // angle(axe, cellule) <= ouverture + rayon de la cellule
+        float cosLimit = cosView * cell.cosRadius - sinView * cell.sinRadius;
+        if (forward.dot(cell.center) < cosLimit) continue;
+        
+        for (int s = cell.first; s < cell.first + cell.count; s++) {
+            const Vector3D& d = directions[s];
+            float w = m.at(3, 0) * d.x + m.at(3, 1) * d.y + m.at(3, 2) * d.z;
+            if (w <= 0.0f) continue;  // Derrière la caméra
+            
+            float invW = 1.0f / w;
+            float cx = m.at(0, 0) * d.x + m.at(0, 1) * d.y + m.at(0, 2) * d.z;
+            float cy = m.at(1, 0) * d.x + m.at(1, 1) * d.y + m.at(1, 2) * d.z;
+            int x = (int)std::floor((cx * invW + 1.0f) * halfW);
+            int y = (int)std::floor((1.0f - cy * invW) * halfH);
+            
+            if (x >= 0 && x < width && y >= 0 && y < height) {
+                out.push_back(SkyPixel{x, y, pixels[s]});
+            }
+        }
+    }
+}
+
+void Rasterizer::drawSky(const std::vector<SkyPixel>& stars) {
+    for (const SkyPixel& star : stars) {
+        if (star.x >= scissor.x0 && star.x <= scissor.x1 &&
+            star.y >= scissor.y0 && star.y <= scissor.y1) {
+            colorBuffer[star.y * width + star.x] = star.color;
+        }
+    }
+}
+
+void Rasterizer::fillRect(int x, int y, int w, int h, SDL_Color color) {
+    // Clipper le rectangle à la zone de dessin
+    int x0 = std::max(scissor.x0, x);
+    int y0 = std::max(scissor.y0, y);
+    int x1 = std::min(scissor.x1 + 1, x + w);
+    int y1 = std::min(scissor.y1 + 1, y + h);
+    if (x0 >= x1 || y0 >= y1) return;
+    
+    if (color.a == 255) {
+        Uint32 pixel = packColor(color);
+        for (int py = y0; py < y1; py++) {
+            std::fill(colorBuffer.begin() + py * width + x0,
+                      colorBuffer.begin() + py * width + x1, pixel);
+        }
+        return;
+    }
     
-    return result;
+    // Mélange alpha : dst = src * a + dst * (1 - a)
+    Uint32 a = color.a;
+    Uint32 inv = 255 - a;
+    for (int py = y0; py < y1; py++) {
+        Uint32* row = &colorBuffer[py * width];
+        for (int px = x0; px < x1; px++) {
+            Uint32 dst = row[px];
+            Uint32 r = (color.r * a + ((dst >> 16) & 0xFF) * inv) / 255;
+            Uint32 g = (color.g * a + ((dst >> 8) & 0xFF) * inv) / 255;
+            Uint32 b = (color.b * a + (dst & 0xFF) * inv) / 255;
+            row[px] = 0xFF000000u | (r << 16) | (g << 8) | b;
+        }
+    }
+}
+
+void Rasterizer::drawRect(int x, int y, int w, int h, SDL_Color color) {
+    fillRect(x, y, w, 1, color);
+    fillRect(x, y + h - 1, w, 1, color);
+    fillRect(x, y, 1, h, color);
+    fillRect(x + w - 1, y, 1, h, color);
+}
+
+void Rasterizer::blendImage(int x, int y, int w, int h, const Uint32* pixels,
+                            const Uint32* background) {
+    int x0 = std::max(scissor.x0, x);
+    int y0 = std::max(scissor.y0, y);
+    int x1 = std::min(scissor.x1 + 1, x + w);
+    int y1 = std::min(scissor.y1 + 1, y + h);
+    if (x0 >= x1 || y0 >= y1) return;
+    
+    // Sans branche : exact aussi pour a = 0 et a = 255
+    for (int py = y0; py < y1; py++) {
+        const Uint32* src = pixels + (py - y) * w - x;
+        const Uint32* back = background + (py - y) * w - x;
+        Uint32* row = &colorBuffer[py * width];
+        for (int px = x0; px < x1; px++) {
+            // Rouge et bleu multipliés ensemble, division par 255 arrondie
+            Uint32 s = src[px];
+            Uint32 dst = back[px];
+            Uint32 inv = 255 - (s >> 24);
+            Uint32 rb = (dst & 0x00FF00FFu) * inv + 0x00800080u;
+            Uint32 g = (dst & 0x0000FF00u) * inv + 0x00008000u;
+            rb = ((rb + ((rb >> 8) & 0x00FF00FFu)) >> 8) & 0x00FF00FFu;
+            g = ((g + ((g >> 8) & 0x0000FF00u)) >> 8) & 0x0000FF00u;
+            row[px] = 0xFF000000u | ((s & 0x00FFFFFFu) + rb + g);
+        }
+    }
 }
 
 void Rasterizer::drawLine(int x0, int y0, int x1, int y1, SDL_Color color) {
-    SDL_SetRenderDrawColor(renderer, color.r, color.g, color.b, color.a);
+    // Centres des pixels ; le segment exclut (x1, y1), ajouté à part
+    Uint32 pixel = packColor(color);
+    drawSegment(x0 + 0.5f, y0 + 0.5f, 0.0f, x1 + 0.5f, y1 + 0.5f, 0.0f, pixel, false);
+    if (x1 >= scissor.x0 && x1 <= scissor.x1 && y1 >= scissor.y0 && y1 <= scissor.y1) {
+        colorBuffer[y1 * width + x1] = pixel;
+    }
+}
+
+void Rasterizer::drawSegment(float x0, float y0, float z0,
+                             float x1, float y1, float z1,
+                             Uint32 pixel, bool depthTested) {
+    float dx = x1 - x0;
+    float dy = y1 - y0;
+    
+    // Segment entièrement hors de la zone de dessin (Liang-Barsky)
+    float t0, t1;
+    if (!clipSegment(x0, y0, dx, dy,
+                     (float)scissor.x0, (float)scissor.y0,
+                     (float)(scissor.x1 + 1), (float)(scissor.y1 + 1), t0, t1)) {
+        return;
+    }
     
-    int dx = abs(x1 - x0);
-    int dy = abs(y1 - y0);
-    int sx = x0 < x1 ? 1 : -1;
-    int sy = y0 < y1 ? 1 : -1;
-    int err = dx - dy;
+    // DDA sur l'axe principal : une colonne (ou ligne) par pixel dont le
+    // centre est dans [début, fin[, dans le sens du tracé (la fin exclue est
+    // le point d'arrivée, même de droite à gauche). Chaque pixel est calculé depuis les
+    // extrémités d'origine, jamais depuis les extrémités clippées : le tracé
+    // est le même quel que soit le scissor (redessin partiel) et les segments
+    // d'une polyligne ne dessinent pas deux fois leurs sommets communs.
+    bool xMajor = std::fabs(dx) >= std::fabs(dy);
+    float a0 = xMajor ? x0 : y0;        // Axe principal
+    float b0 = xMajor ? y0 : x0;        // Axe secondaire
+    float da = xMajor ? dx : dy;
+    float db = xMajor ? dy : dx;
+    if (da == 0.0f) return;
+    float slope = db / da;
+    float zSlope = (z1 - z0) / da;
     
-    int maxSteps = std::max(width, height) * 2;
-    int steps = 0;
+    // Partie visible sur l'axe principal, élargie d'un pixel (arrondis) ;
+    // l'axe secondaire est vérifié par pixel
+    float ca = a0 + t0 * da;
+    float cb = a0 + t1 * da;
+    int first, last;
+    if (da > 0.0f) {
+        first = (int)std::ceil(a0 - 0.5f);
+        last = (int)std::ceil(a0 + da - 0.5f) - 1;
+    } else {
+        first = (int)std::floor(a0 + da - 0.5f) + 1;
+        last = (int)std::floor(a0 - 0.5f);
+    }
+    first = std::max(first, (int)std::floor(std::min(ca, cb)) - 1);
+    last = std::min(last, (int)std::floor(std::max(ca, cb)) + 1);
+    
+    int minA = xMajor ? scissor.x0 : scissor.y0;
+    int maxA = xMajor ? scissor.x1 : scissor.y1;
+    int minB = xMajor ? scissor.y0 : scissor.x0;
+    int maxB = xMajor ? scissor.y1 : scissor.x1;
+    first = std::max(first, minA);
+    last = std::min(last, maxA);
+    
+    int strideA = xMajor ? 1 : width;
+    int strideB = xMajor ? width : 1;
     
-    while (steps++ < maxSteps) {
-        SDL_RenderPoint(renderer, x0, y0);
+    for (int a = first; a <= last; a++) {
+        float offset = (a + 0.5f) - a0;
+        int b = (int)std::floor(b0 + offset * slope);
+        if (b < minB || b > maxB) continue;
         
-        if (x0 == x1 && y0 == y1) break;
+        int index = a * strideA + b * strideB;
+        if (!depthTested || isDepthVisible(index, z0 + offset * zSlope)) {
+            colorBuffer[index] = pixel;
+        }
+    }
+}
+
+void Rasterizer::drawLine3D(const Vector3D& a, const Vector3D& b,
+                            const Matrix4x4& viewProjection,
+                            SDL_Color color, bool depthTested) {
+    Vector3D points[2] = {a, b};
+    drawPolyline(points, 2, false, viewProjection, color, depthTested);
+}
+
+void Rasterizer::drawPolyline(const Vector3D* points, int count, bool closed,
+                              const Matrix4x4& viewProjection,
+                              SDL_Color color, bool depthTested) {
+    if (count < 2) return;
+    
+    // Projection de tous les points en une passe
+    clipPositions.resize(count);
+    lineVertices.resize(count);
+    viewProjection.transformHomogeneousBatch(points, count, clipPositions.data());
+    for (int i = 0; i < count; i++) {
+        ProjectedVertex& v = lineVertices[i];
+        v.clip = clipPositions[i];
+        v.outcode = v.clip.z < -v.clip.w ? CLIP_NEAR : 0;
+        if (!v.outcode) {
+            toScreen(v);
+        }
+    }
+    
+    Uint32 pixel = packColor(color);
+    int segments = closed ? count : count - 1;
+    for (int i = 0; i < segments; i++) {
+        const ProjectedVertex& a = lineVertices[i];
+        const ProjectedVertex& b = lineVertices[(i + 1) % count];
         
-        int e2 = 2 * err;
-        if (e2 > -dy) {
-            err -= dy;
-            x0 += sx;
+        if (!(a.outcode | b.outcode)) {
+            drawSegment(a.x, a.y, a.z, b.x, b.y, b.z, pixel, depthTested);
+            continue;
         }
-        if (e2 < dx) {
-            err += dx;
-            y0 += sy;
+        if (a.outcode & b.outcode) continue;  // Entièrement derrière la caméra
+        
+        // Clipping au plan proche en clip space (w > 0 ensuite)
+        float da = a.clip.z + a.clip.w;
+        float db = b.clip.z + b.clip.w;
+        float t = da / (da - db);
+        ProjectedVertex p;
+        p.clip.x = a.clip.x + t * (b.clip.x - a.clip.x);
+        p.clip.y = a.clip.y + t * (b.clip.y - a.clip.y);
+        p.clip.z = a.clip.z + t * (b.clip.z - a.clip.z);
+        p.clip.w = a.clip.w + t * (b.clip.w - a.clip.w);
+        toScreen(p);
+        
+        if (a.outcode) {
+            drawSegment(p.x, p.y, p.z, b.x, b.y, b.z, pixel, depthTested);
+        } else {
+            drawSegment(a.x, a.y, a.z, p.x, p.y, p.z, pixel, depthTested);
         }
     }
 }
 
-void Rasterizer::fillTriangle(const ProjectedVertex& v0,
-                               const ProjectedVertex& v1,
-                               const ProjectedVertex& v2,
-                               SDL_Color baseColor) {
-    // Trier les vertices par Y
-    ProjectedVertex verts[3] = {v0, v1, v2};
-    if (verts[0].y > verts[1].y) std::swap(verts[0], verts[1]);
-    if (verts[1].y > verts[2].y) std::swap(verts[1], verts[2]);
-    if (verts[0].y > verts[1].y) std::swap(verts[0], verts[1]);
+void Rasterizer::fillTriangle(const RasterTriangle& tri) {
+    FixedEdges edges;
+    if (!edges.setup(tri.fx, tri.fy)) return;
+    
+    int minX = std::max(scissor.x0, edges.minX);
+    int maxX = std::min(scissor.x1, edges.maxX);
+    int minY = std::max(scissor.y0, edges.minY);
+    int maxY = std::min(scissor.y1, edges.maxY);
+    if (minX > maxX || minY > maxY) return;
+    
+    // Gradients constants de profondeur (sur les positions arrondies)
+    const float* vx = tri.x;
+    const float* vy = tri.y;
+    const float* vz = tri.z;
+    float area = (vx[1] - vx[0]) * (vy[2] - vy[0]) - (vy[1] - vy[0]) * (vx[2] - vx[0]);
+    float dzdx = ((vz[1] - vz[0]) * (vy[2] - vy[0]) - (vz[2] - vz[0]) * (vy[1] - vy[0])) / area;
+    float dzdy = ((vz[2] - vz[0]) * (vx[1] - vx[0]) - (vz[1] - vz[0]) * (vx[2] - vx[0])) / area;
+    
+    // Scanline : intervalle couvert exact de chaque ligne
+    int shaded = 0;
+    for (int y = minY; y <= maxY; y++) {
+        int x0, x1;
+        if (!edges.rowInterval(y, minX, maxX, x0, x1)) continue;
+        
+        float z = vz[0] + dzdx * (x0 + 0.5f - vx[0]) + dzdy * (y + 0.5f - vy[0]);
+        shadeSpan(y, x0, x1, z, dzdx, tri.pixel);
+        shaded += x1 - x0 + 1;
+    }
+    
+    depthBytes.fetch_add((Uint64)shaded * depthPixelBytes(), std::memory_order_relaxed);
+}
+
+void Rasterizer::shadeSpan(int y, int x0, int x1, float z, float dzdx, Uint32 pixel) {
+    int index = y * width + x0;
+    switch (depthFormat) {
+        case DepthFormat::UNORM24:
+            depthSpan24(&zBuffer24[index], &colorBuffer[index], x1 - x0 + 1, z, dzdx, pixel,
+                        depthGeneration << 24);
+            break;
+        case DepthFormat::UNORM16:
+            depthSpan16(&zBuffer16[index], &colorBuffer[index], x1 - x0 + 1, z, dzdx, pixel);
+            break;
+        case DepthFormat::FLOAT32:
+        case DepthFormat::FLOAT32_REVERSED:
+            depthSpan(&zBuffer[index], &colorBuffer[index], x1 - x0 + 1, z, dzdx, pixel);
+            break;
+    }
+    
+    // Marquer les tuiles du Hierarchical Z touchées
+    const int T = Constants::RASTER_TILE_SIZE;
+    const int B = Constants::BIN_TILE_SIZE;
+    Uint8* tiles = &tileFlags[(y / T) * hiZColumns];
+    for (int tx = x0 / T; tx <= x1 / T; tx++) {
+        tiles[tx] = TILE_HIZ_DIRTY | TILE_DEPTH_WRITTEN;
+    }
+    Uint8* blocks = &hiZ1Dirty[(y / B) * binColumns];
+    for (int bx = x0 / B; bx <= x1 / B; bx++) {
+        blocks[bx] = 1;
+    }
+}
+
+Rasterizer::RasterTriangle Rasterizer::setupTriangle(const ProjectedVertex& v0,
+                                                     const ProjectedVertex& v1,
+                                                     const ProjectedVertex& v2,
+                                                     SDL_Color baseColor) {
+    RasterTriangle triangle;
+    const ProjectedVertex* v[3] = {&v0, &v1, &v2};
+    for (int i = 0; i < 3; i++) {
+        // Arrondi au sous-pixel le plus proche
+        triangle.fx[i] = (int)std::lround(v[i]->x * SUBPIXEL);
+        triangle.fy[i] = (int)std::lround(v[i]->y * SUBPIXEL);
+        triangle.x[i] = (float)triangle.fx[i] / SUBPIXEL;
+        triangle.y[i] = (float)triangle.fy[i] / SUBPIXEL;
+        triangle.z[i] = v[i]->z;
+    }
     
     // Normale moyenne pour l'éclairage
     Vector3D avgNormal = (v0.normal + v1.normal + v2.normal) * (1.0f / 3.0f);
     avgNormal.normalize();
-    SDL_Color litColor = calculateLighting(avgNormal, baseColor);
+    triangle.pixel = packColor(calculateLighting(avgNormal, baseColor));
     
-    // Scanline rasterization (simplifié)
-    int minY = std::max(0, (int)verts[0].y);
-    int maxY = std::min(height - 1, (int)verts[2].y);
+    return triangle;
+}
+
+void Rasterizer::fillTriangleTiled(const RasterTriangle& tri, const ScreenRect& clip) {
+    const float* vx = tri.x;
+    const float* vy = tri.y;
+    const float* vz = tri.z;
+    const Uint32 pixel = tri.pixel;
     
-    for (int y = minY; y <= maxY; y++) {
-        // Trouver les intersections avec les bords du triangle
-        float t1 = (verts[2].y - verts[0].y) > 0.001f ? 
-                   (y - verts[0].y) / (verts[2].y - verts[0].y) : 0.0f;
-        
-        float x1 = verts[0].x + t1 * (verts[2].x - verts[0].x);
-        float z1 = verts[0].z + t1 * (verts[2].z - verts[0].z);
-        
-        float x2, z2;
-        if (y < verts[1].y) {
-            float t2 = (verts[1].y - verts[0].y) > 0.001f ? 
-                       (y - verts[0].y) / (verts[1].y - verts[0].y) : 0.0f;
-            x2 = verts[0].x + t2 * (verts[1].x - verts[0].x);
-            z2 = verts[0].z + t2 * (verts[1].z - verts[0].z);
-        } else {
-            float t2 = (verts[2].y - verts[1].y) > 0.001f ? 
-                       (y - verts[1].y) / (verts[2].y - verts[1].y) : 0.0f;
-            x2 = verts[1].x + t2 * (verts[2].x - verts[1].x);
-            z2 = verts[1].z + t2 * (verts[2].z - verts[1].z);
+    // Fonctions d'arête entières (rejette aussi les triangles de dos ou dégénérés)
+    FixedEdges edges;
+    if (!edges.setup(tri.fx, tri.fy)) return;
+    
+    // Bounding box clippée au rectangle de travail (écran ou tuile)
+    int minX = std::max(clip.x0, edges.minX);
+    int maxX = std::min(clip.x1, edges.maxX);
+    int minY = std::max(clip.y0, edges.minY);
+    int maxY = std::min(clip.y1, edges.maxY);
+    if (minX > maxX || minY > maxY) return;
+    
+    // Gradients constants de profondeur (sur les positions arrondies)
+    float area = (vx[1] - vx[0]) * (vy[2] - vy[0]) - (vy[1] - vy[0]) * (vx[2] - vx[0]);
+    float dzdx = ((vz[1] - vz[0]) * (vy[2] - vy[0]) - (vz[2] - vz[0]) * (vy[1] - vy[0])) / area;
+    float dzdy = ((vz[2] - vz[0]) * (vx[1] - vx[0]) - (vz[1] - vz[0]) * (vx[2] - vx[0])) / area;
+    
+    // Profondeur la plus proche du triangle (pour le Hierarchical Z)
+    float zMin = std::min({vz[0], vz[1], vz[2]});
+    int rejectedTiles = 0;
+    int shaded = 0;
+    
+    const int T = Constants::RASTER_TILE_SIZE;
+    
+    for (int ty = minY & ~(T - 1); ty <= maxY; ty += T) {
+        for (int tx = minX & ~(T - 1); tx <= maxX; tx += T) {
+            // Arêtes aux coins de la tuile (centres des pixels extrêmes)
+            bool rejected = false;
+            bool accepted = true;
+            for (int i = 0; i < 3; i++) {
+                int64_t e = edges.at(i, tx, ty);
+                int64_t dx = edges.stepX[i] * (T - 1);
+                int64_t dy = edges.stepY[i] * (T - 1);
+                int64_t eMin = e + std::min<int64_t>(0, dx) + std::min<int64_t>(0, dy);
+                int64_t eMax = e + std::max<int64_t>(0, dx) + std::max<int64_t>(0, dy);
+                if (eMax < 0) { rejected = true; break; }
+                if (eMin < 0) accepted = false;
+            }
+            if (rejected) continue;
+            
+            // Tuile déjà entièrement plus proche que le triangle
+            if (zMin > getTileMaxDepth(tx / T, ty / T)) {
+                rejectedTiles++;
+                continue;
+            }
+            
+            // Portion de la tuile dans la bounding box
+            int x0 = std::max(tx, minX);
+            int x1 = std::min(tx + T - 1, maxX);
+            int y0 = std::max(ty, minY);
+            int y1 = std::min(ty + T - 1, maxY);
+            
+            float zRow = vz[0] + dzdx * (x0 + 0.5f - vx[0]) + dzdy * (y0 + 0.5f - vy[0]);
+            
+            if (accepted) {
+                // Tuile entièrement couverte : pas de test d'arête
+                for (int y = y0; y <= y1; y++, zRow += dzdy) {
+                    shadeSpan(y, x0, x1, zRow, dzdx, pixel);
+                }
+                shaded += (x1 - x0 + 1) * (y1 - y0 + 1);
+                continue;
+            }
+            
+            // Tuile partielle : intervalle couvert exact de chaque ligne
+            for (int y = y0; y <= y1; y++, zRow += dzdy) {
+                int first, last;
+                if (edges.rowInterval(y, x0, x1, first, last)) {
+                    shadeSpan(y, first, last, zRow + dzdx * (first - x0), dzdx, pixel);
+                    shaded += last - first + 1;
+                }
+            }
         }
-        
-        if (x1 > x2) {
-            std::swap(x1, x2);
-            std::swap(z1, z2);
+    }
+    
+    if (rejectedTiles > 0) {
+        earlyRejectedTiles.fetch_add(rejectedTiles, std::memory_order_relaxed);
+    }
+    depthBytes.fetch_add((Uint64)shaded * depthPixelBytes(), std::memory_order_relaxed);
+}
+
+void Rasterizer::binTriangle(const RasterTriangle& tri) {
+    // Bounding box du triangle dans la zone de dessin
+    int minX = std::max(scissor.x0, (int)std::floor(std::min({tri.x[0], tri.x[1], tri.x[2]})));
+    int maxX = std::min(scissor.x1, (int)std::ceil(std::max({tri.x[0], tri.x[1], tri.x[2]})));
+    int minY = std::max(scissor.y0, (int)std::floor(std::min({tri.y[0], tri.y[1], tri.y[2]})));
+    int maxY = std::min(scissor.y1, (int)std::ceil(std::max({tri.y[0], tri.y[1], tri.y[2]})));
+    if (minX > maxX || minY > maxY) return;
+    
+    int index = (int)binnedTriangles.size();
+    binnedTriangles.push_back(tri);
+    
+    const int B = Constants::BIN_TILE_SIZE;
+    for (int by = minY / B; by <= maxY / B; by++) {
+        for (int bx = minX / B; bx <= maxX / B; bx++) {
+            bins[by * binColumns + bx].push_back(index);
         }
+    }
+}
+
+void Rasterizer::flush() {
+    if (binnedTriangles.empty()) return;
+    PROFILE_SCOPE("Rasterizer::flush");
+    
+    const int B = Constants::BIN_TILE_SIZE;
+    threadPool->parallelFor(binColumns * binRows, [this, B](int bin, int) {
+        const std::vector<int>& triangles = bins[bin];
+        if (triangles.empty()) return;
+        PROFILE_SCOPE("flush: tile");
         
-        int startX = std::max(0, (int)x1);
-        int endX = std::min(width - 1, (int)x2);
+        // Rectangle de la tuile (dans la zone de dessin) : aucun autre thread n'y écrit
+        int bx = bin % binColumns;
+        int by = bin / binColumns;
+        ScreenRect tile = {
+            std::max(scissor.x0, bx * B), std::max(scissor.y0, by * B),
+            std::min(scissor.x1, (bx + 1) * B - 1), std::min(scissor.y1, (by + 1) * B - 1)
+        };
         
-        for (int x = startX; x <= endX; x++) {
-            float t = (x2 - x1) > 0.001f ? (x - x1) / (x2 - x1) : 0.0f;
-            float z = z1 + t * (z2 - z1);
-            
-            if (depthTest(x, y, z)) {
-                SDL_SetRenderDrawColor(renderer, litColor.r, litColor.g, litColor.b, litColor.a);
-                SDL_RenderPoint(renderer, x, y);
+        // Ordre de soumission conservé dans chaque tuile
+        for (int index : triangles) {
+            fillTriangleTiled(binnedTriangles[index], tile);
+        }
+    });
+    
+    binnedTriangles.clear();
+    for (auto& bin : bins) {
+        bin.clear();
+    }
+}
+
+void Rasterizer::flushOverlapping(const ScreenRect& rect) {
+    if (binnedTriangles.empty()) return;
+    
+    int x0 = std::max(scissor.x0, rect.x0);
+    int y0 = std::max(scissor.y0, rect.y0);
+    int x1 = std::min(scissor.x1, rect.x1);
+    int y1 = std::min(scissor.y1, rect.y1);
+    if (x0 > x1 || y0 > y1) return;
+    
+    const int B = Constants::BIN_TILE_SIZE;
+    for (int by = y0 / B; by <= y1 / B; by++) {
+        for (int bx = x0 / B; bx <= x1 / B; bx++) {
+            if (!bins[by * binColumns + bx].empty()) {
+                flush();
+                return;
             }
         }
     }
@@ -190,67 +1242,291 @@ void Rasterizer::drawMesh(const Mesh* mesh,
     
     Matrix4x4 mvp = projection * view * model;
     
-    const std::vector<Vertex>& vertices = mesh->getVertices();
-    const std::vector<int>& indices = mesh->getIndices();
-    
-    // Projeter tous les vertices
-    std::vector<ProjectedVertex> projectedVerts;
-    projectedVerts.reserve(vertices.size());
+    int vertexCount = mesh->getVertexCount();
     
-    for (const auto& vertex : vertices) {
-        // Transformer la normale
-        Vector3D transformedNormal = model.transformVector(vertex.normal);
-        transformedNormal.normalize();
-        
-        Vertex transformedVertex = vertex;
-        transformedVertex.normal = transformedNormal;
+    // Projeter tous les vertices : flux de positions et de normales
+    // transformés par lots (SIMD), puis outcodes et coordonnées écran
+    {
+        PROFILE_SCOPE("drawMesh: projection");
+        clipPositions.resize(vertexCount);
+        worldNormals.resize(vertexCount);
+        meshVertices.resize(vertexCount);
+        mvp.transformHomogeneousBatch(mesh->getPositions(), vertexCount, clipPositions.data());
+        model.transformNormalsBatch(mesh->getNormals(), vertexCount, worldNormals.data());
         
-        projectedVerts.push_back(projectVertex(transformedVertex, mvp));
+        for (int i = 0; i < vertexCount; i++) {
+            ProjectedVertex& projected = meshVertices[i];
+            projected.clip = clipPositions[i];
+            projected.normal = worldNormals[i];
+            projected.outcode = computeOutcode(projected.clip);
+            
+            // La division n'a de sens que devant le plan proche (w > 0)
+            if (!(projected.outcode & CLIP_NEAR)) {
+                toScreen(projected);
+            } else {
+                projected.x = projected.y = projected.z = 0.0f;
+            }
+        }
     }
     
-    // Dessiner tous les triangles
+    // Dessiner tous les triangles (rasterisés ici, ou seulement triés par
+    // tuile en mode tuilé : voir flush)
+    PROFILE_SCOPE("drawMesh: triangles");
     lastTriangleCount = 0;
     culledTriangleCount = 0;
+    clippedTriangleCount = 0;
     
-    for (size_t i = 0; i < indices.size(); i += 3) {
-        int i0 = indices[i];
-        int i1 = indices[i + 1];
-        int i2 = indices[i + 2];
-        
-        const ProjectedVertex& p0 = projectedVerts[i0];
-        const ProjectedVertex& p1 = projectedVerts[i1];
-        const ProjectedVertex& p2 = projectedVerts[i2];
+    // Binning en mode tuilé, quel que soit le nombre de threads : le Z-Buffer
+    // vu par les tests HiZ (donc les rejets) ne dépend pas du parallélisme.
+    // Le mode fil de fer et le scanline restent immédiats.
+    bool deferred = rasterMode == RasterMode::TILED && !wireframeMode;
+    
+    if (mesh->hasShortIndices()) {
+        submitTriangles(mesh->getShortIndices(), mesh->getIndexCount(), color, deferred);
+    } else {
+        submitTriangles(mesh->getLongIndices(), mesh->getIndexCount(), color, deferred);
+    }
+}
+
+template <typename Index>
+void Rasterizer::submitTriangles(const Index* indices, int indexCount, SDL_Color color, bool deferred) {
+    for (int i = 0; i + 2 < indexCount; i += 3) {
+        const ProjectedVertex& p0 = meshVertices[indices[i]];
+        const ProjectedVertex& p1 = meshVertices[indices[i + 1]];
+        const ProjectedVertex& p2 = meshVertices[indices[i + 2]];
         
-        // Backface culling
-        float cross = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
-        if (cross < 0) {
+        int outside = p0.outcode | p1.outcode | p2.outcode;
+        if (outside == 0) {
+            // Cas courant : rien à clipper
+            submitTriangle(p0, p1, p2, color, deferred);
+        } else if (p0.outcode & p1.outcode & p2.outcode) {
+            // Entièrement du mauvais côté d'un même plan
             culledTriangleCount++;
-            continue;
+            frameCulledTriangleCount++;
+        } else {
+            // Traverse le plan proche ou sort de la guard band
+            clipAndSubmit(p0, p1, p2, outside, color, deferred);
         }
+    }
+}
+
+void Rasterizer::clipAndSubmit(const ProjectedVertex& v0,
+                               const ProjectedVertex& v1,
+                               const ProjectedVertex& v2,
+                               int planes, SDL_Color color, bool deferred) {
+    clippedTriangleCount++;
+    
+    // Un triangle clippé par 5 plans a au plus 8 sommets
+    const int MAX_VERTS = 9;
+    ProjectedVertex bufferA[MAX_VERTS];
+    ProjectedVertex bufferB[MAX_VERTS];
+    ProjectedVertex* input = bufferA;
+    ProjectedVertex* output = bufferB;
+    int count = 3;
+    input[0] = v0;
+    input[1] = v1;
+    input[2] = v2;
+    
+    for (int plane = CLIP_NEAR; plane <= CLIP_TOP && count >= 3; plane <<= 1) {
+        if (!(planes & plane)) continue;
         
-        if (wireframeMode) {
-            // Mode fil de fer
-            SDL_Color wireColor = {0, 255, 0, 255};
-            if (p0.visible && p1.visible) drawLine((int)p0.x, (int)p0.y, (int)p1.x, (int)p1.y, wireColor);
-            if (p1.visible && p2.visible) drawLine((int)p1.x, (int)p1.y, (int)p2.x, (int)p2.y, wireColor);
-            if (p2.visible && p0.visible) drawLine((int)p2.x, (int)p2.y, (int)p0.x, (int)p0.y, wireColor);
-        } else {
-            // Mode rempli avec éclairage
-            fillTriangle(p0, p1, p2, color);
+        // Distance signée au plan (positive = côté visible)
+        auto distance = [this, plane](const Vector4D& c) {
+            switch (plane) {
+                case CLIP_NEAR:   return c.z + c.w;
+                case CLIP_LEFT:   return c.x + guardBandX * c.w;
+                case CLIP_RIGHT:  return guardBandX * c.w - c.x;
+                case CLIP_BOTTOM: return c.y + guardBandY * c.w;
+                default:          return guardBandY * c.w - c.y;
+            }
+        };
+        
+        int outCount = 0;
+        for (int i = 0; i < count; i++) {
+            const ProjectedVertex& a = input[i];
+            const ProjectedVertex& b = input[(i + 1) % count];
+            float da = distance(a.clip);
+            float db = distance(b.clip);
+            
+            if (da >= 0.0f) {
+                output[outCount++] = a;
+            }
+            if ((da >= 0.0f) != (db >= 0.0f)) {
+                // Intersection de l'arête avec le plan
+                float t = da / (da - db);
+                ProjectedVertex& p = output[outCount++];
+                p.clip.x = a.clip.x + t * (b.clip.x - a.clip.x);
+                p.clip.y = a.clip.y + t * (b.clip.y - a.clip.y);
+                p.clip.z = a.clip.z + t * (b.clip.z - a.clip.z);
+                p.clip.w = a.clip.w + t * (b.clip.w - a.clip.w);
+                p.normal = a.normal + (b.normal - a.normal) * t;
+            }
         }
         
-        lastTriangleCount++;
+        std::swap(input, output);
+        count = outCount;
+    }
+    
+    if (count < 3) return;
+    
+    for (int i = 0; i < count; i++) {
+        input[i].outcode = 0;
+        toScreen(input[i]);
+    }
+    
+    // Éventail autour du premier sommet
+    for (int i = 1; i + 1 < count; i++) {
+        submitTriangle(input[0], input[i], input[i + 1], color, deferred);
+    }
+}
+
+void Rasterizer::submitTriangle(const ProjectedVertex& p0,
+                                const ProjectedVertex& p1,
+                                const ProjectedVertex& p2,
+                                SDL_Color color, bool deferred) {
+    // Backface culling
+    float cross = (p1.x - p0.x) * (p2.y - p0.y) - (p1.y - p0.y) * (p2.x - p0.x);
+    if (cross < 0) {
+        culledTriangleCount++;
+        frameCulledTriangleCount++;
+        return;
+    }
+    
+    // Rejet précoce : triangle entièrement derrière le Z-Buffer actuel
+    if (!wireframeMode) {
+        ScreenRect bounds = {
+            (int)std::floor(std::min({p0.x, p1.x, p2.x})),
+            (int)std::floor(std::min({p0.y, p1.y, p2.y})),
+            (int)std::ceil(std::max({p0.x, p1.x, p2.x})),
+            (int)std::ceil(std::max({p0.y, p1.y, p2.y}))
+        };
+        if (isOccluded(bounds, std::min({p0.z, p1.z, p2.z}))) {
+            earlyRejectedTriangles++;
+            return;
+        }
+    }
+    
+    if (wireframeMode) {
+        // Mode fil de fer
+        Uint32 wirePixel = packColor(SDL_Color{0, 255, 0, 255});
+        drawSegment(p0.x, p0.y, p0.z, p1.x, p1.y, p1.z, wirePixel, false);
+        drawSegment(p1.x, p1.y, p1.z, p2.x, p2.y, p2.z, wirePixel, false);
+        drawSegment(p2.x, p2.y, p2.z, p0.x, p0.y, p0.z, wirePixel, false);
+    } else {
+        // Mode rempli avec éclairage
+        if (deferred) {
+            binTriangle(setupTriangle(p0, p1, p2, color));
+        } else if (rasterMode == RasterMode::TILED) {
+            fillTriangleTiled(setupTriangle(p0, p1, p2, color), scissor);
+        } else {
+            fillTriangle(setupTriangle(p0, p1, p2, color));
+        }
     }
+    
+    lastTriangleCount++;
+    frameTriangleCount++;
 }
 
 void Rasterizer::setWireframeMode(bool enabled) {
     wireframeMode = enabled;
+    settingsRevision++;
 }
 
 bool Rasterizer::isWireframeMode() const {
     return wireframeMode;
 }
 
+void Rasterizer::setImpostorMode(bool enabled) {
+    impostorMode = enabled;
+    settingsRevision++;
+}
+
+bool Rasterizer::isImpostorMode() const {
+    return impostorMode;
+}
+
+void Rasterizer::setRasterMode(RasterMode mode) {
+    rasterMode = mode;
+    settingsRevision++;
+}
+
+RasterMode Rasterizer::getRasterMode() const {
+    return rasterMode;
+}
+
+void Rasterizer::setSpanKernelLevel(SpanKernels::Level level) {
+    // Ne jamais dépasser ce que le CPU supporte
+    if ((int)level > (int)SpanKernels::detect()) {
+        level = SpanKernels::detect();
+    }
+    spanKernelLevel = level;
+    depthSpan = SpanKernels::get(level);
+    depthSpan24 = SpanKernels::getUnorm24(level);
+    depthSpan16 = SpanKernels::getUnorm16(level);
+}
+
+SpanKernels::Level Rasterizer::getSpanKernelLevel() const {
+    return spanKernelLevel;
+}
+
+void Rasterizer::setDepthFormat(DepthFormat format) {
+    if (format == depthFormat) return;
+    depthFormat = format;
+    allocateZBuffer();
+    settingsRevision++;
+}
+
+DepthFormat Rasterizer::getDepthFormat() const {
+    return depthFormat;
+}
+
+const char* Rasterizer::getDepthFormatName(DepthFormat format) {
+    switch (format) {
+        case DepthFormat::FLOAT32_REVERSED:
+            return "Float32 inversé";
+        case DepthFormat::UNORM24:
+            return "Unorm24";
+        case DepthFormat::UNORM16:
+            return "Unorm16";
+        case DepthFormat::FLOAT32:
+            break;
+    }
+    return "Float32";
+}
+
+void Rasterizer::setDepthRange(float nearPlane, float farPlane) {
+    depthNear = nearPlane;
+    depthFar = farPlane;
+}
+
+Uint64 Rasterizer::getDepthBytes() const {
+    return depthBytes;
+}
+
 int Rasterizer::getLastTriangleCount() const {
     return lastTriangleCount;
+}
+
+int Rasterizer::getFrameTriangleCount() const {
+    return frameTriangleCount;
+}
+
+int Rasterizer::getFrameCulledTriangleCount() const {
+    return frameCulledTriangleCount;
+}
+
+int Rasterizer::getClippedTriangleCount() const {
+    return clippedTriangleCount;
+}
+
+int Rasterizer::getEarlyRejectedTiles() const {
+    return earlyRejectedTiles.load(std::memory_order_relaxed);
+}
+
+int Rasterizer::getEarlyRejectedTriangles() const {
+    return earlyRejectedTriangles;
+}
+
+int Rasterizer::getEarlyRejectedBodies() const {
+    return earlyRejectedBodies;
 }
\ No newline at end of file
@@ -1,152 +1,421 @@
 #include "renderer3D.h"
-#include "Constants.h"
+#include "constants.h"
+#include "profiler.h"
+#include <algorithm>
 #include <cmath>
+#include <cstring>
+#include <iostream>
 #include <random>
 
 Renderer3D::Renderer3D(SDL_Renderer* renderer, int width, int height)
     : sdlRenderer(renderer)
+    , frameTexture(nullptr)
     , screenWidth(width)
     , screenHeight(height)
     , showOrbits(true)
     , showStars(false)
-    , showInfo(true) {
+    , showInfo(true)
+    , incrementalRedraw(Constants::INCREMENTAL_REDRAW)
+    , fullRedrawPending(true)
+    , lastSettingsRevision(-1)
+    , frameRedraw(FrameRedraw::FULL)
+    , nominalTimings(false)
+    , lastInfoTime(0)
+    , hudBackgroundValid(false) {
     
-    rasterizer = new Rasterizer(renderer, width, height);
+    rasterizer = new Rasterizer(width, height);
+    starSky = new StarSky(Constants::SKY_FACE_SIZE);
+    hud = new Hud(Constants::HUD_WIDTH, Constants::HUD_HEIGHT);
+    hudBackground.resize(hud->getWidth() * hud->getHeight());
+    createFrameTexture();
     generateStars();
 }
 
 Renderer3D::~Renderer3D() {
+    if (frameTexture) {
+        SDL_DestroyTexture(frameTexture);
+    }
+    delete hud;
+    delete starSky;
     delete rasterizer;
 }
 
-void Renderer3D::generateStars() {
-    stars.clear();
+void Renderer3D::createFrameTexture() {
+    if (frameTexture) {
+        SDL_DestroyTexture(frameTexture);
+        frameTexture = nullptr;
+    }
     
-    std::random_device rd;
-    std::mt19937 gen(rd());
-    std::uniform_real_distribution<float> posDist(-500.0f, 500.0f);
-    std::uniform_real_distribution<float> brightDist(0.3f, 1.0f);
-    std::uniform_real_distribution<float> sizeDist(0.5f, 2.0f);
-    
-    for (int i = 0; i < Constants::MAX_STARS; i++) {
-        Star star;
-        star.position = Vector3D(
-            posDist(gen),
-            posDist(gen),
-            posDist(gen)
-        );
-        star.brightness = brightDist(gen);
-        star.size = sizeDist(gen);
-        stars.push_back(star);
+    // Mode headless : le framebuffer reste en mémoire
+    if (!sdlRenderer) return;
+    
+    frameTexture = SDL_CreateTexture(sdlRenderer,
+                                     SDL_PIXELFORMAT_XRGB8888,
+                                     SDL_TEXTUREACCESS_STREAMING,
+                                     screenWidth,
+                                     screenHeight);
+    if (!frameTexture) {
+        std::cerr << "[ERREUR] Creation texture frame: " << SDL_GetError() << std::endl;
     }
 }
 
-void Renderer3D::renderStars(Camera* camera) {
-    if (!showStars) return;
+void Renderer3D::generateStars() {
+    std::random_device rd;
+    setStarSeed(rd());
+}
+
+void Renderer3D::setStarSeed(unsigned int seed) {
+    starSky->generate(Constants::MAX_STARS, seed);
+    fullRedrawPending = true;
+}
+
+void Renderer3D::clear() {
+    rasterizer->clear();
+    fullRedrawPending = true;
+}
+
+void Renderer3D::present() {
+    PROFILE_SCOPE("Renderer3D::present");
     
-    Matrix4x4 viewProj = camera->getViewProjectionMatrix();
+    if (!sdlRenderer) return;
     
-    for (const auto& star : stars) {
-        Vector3D projected = viewProj.transformPoint(star.position);
-        
-        // Convertir en coordonnées écran
-        float x = (projected.x + 1.0f) * 0.5f * screenWidth;
-        float y = (1.0f - projected.y) * 0.5f * screenHeight;
+    Uint64 start = Profiler::now();
+    if (frameTexture) {
+        // Un seul upload : copie ligne par ligne (le pitch de la texture peut différer)
+        // La texture garde la frame précédente : seules les zones redessinées
+        // sont envoyées (aucune si rien n'a changé)
+        std::vector<ScreenRect> uploads;
+        if (frameRedraw == FrameRedraw::FULL) {
+            uploads.push_back({0, 0, screenWidth - 1, screenHeight - 1});
+        } else {
+            uploads = dirtyRects;
+        }
         
-        // Vérifier si visible
-        if (x >= 0 && x < screenWidth && y >= 0 && y < screenHeight) {
-            Uint8 brightness = (Uint8)(255 * star.brightness);
-            SDL_SetRenderDrawColor(sdlRenderer, brightness, brightness, brightness, 255);
+        const Uint32* src = rasterizer->getColorBuffer();
+        for (const ScreenRect& rect : uploads) {
+            SDL_Rect area = {rect.x0, rect.y0, rect.x1 - rect.x0 + 1, rect.y1 - rect.y0 + 1};
+            const Uint32* first = src + rect.y0 * screenWidth + rect.x0;
+            size_t rowBytes = area.w * sizeof(Uint32);
             
-            // Dessiner l'étoile (petit carré ou point)
-            if (star.size > 1.5f) {
-                SDL_FRect rect = {x - star.size/2, y - star.size/2, star.size, star.size};
-                SDL_RenderFillRect(sdlRenderer, &rect);
+            void* pixels = nullptr;
+            int pitch = 0;
+            if (SDL_LockTexture(frameTexture, &area, &pixels, &pitch)) {
+                Uint8* dst = (Uint8*)pixels;
+                for (int y = 0; y < area.h; y++) {
+                    std::memcpy(dst + y * pitch, first + y * screenWidth, rowBytes);
+                }
+                SDL_UnlockTexture(frameTexture);
             } else {
-                SDL_RenderPoint(sdlRenderer, x, y);
+                SDL_UpdateTexture(frameTexture, &area, first, screenWidth * (int)sizeof(Uint32));
             }
         }
+        
+        SDL_RenderTexture(sdlRenderer, frameTexture, nullptr, nullptr);
     }
+    
+    SDL_RenderPresent(sdlRenderer);
+    hud->addStageTime(Hud::STAGE_PRESENT, (Profiler::now() - start) / 1e6);
 }
 
-void Renderer3D::clear() {
-    rasterizer->clear();
+void Renderer3D::presentCached() {
+    if (!sdlRenderer) return;
+    
+    if (frameTexture) {
+        SDL_RenderTexture(sdlRenderer, frameTexture, nullptr, nullptr);
+    }
+    SDL_RenderPresent(sdlRenderer);
 }
 
-void Renderer3D::present() {
-    SDL_RenderPresent(sdlRenderer);
+bool Renderer3D::isUpToDate(SolarSystem* solarSystem, Camera* camera) const {
+    if (fullRedrawPending ||
+        camera->getViewProjectionMatrix() != lastViewProjection ||
+        rasterizer->getSettingsRevision() != lastSettingsRevision) {
+        return false;
+    }
+    
+    const std::vector<CelestialBody*>& bodies = solarSystem->getBodies();
+    if (bodies.size() != lastBodyModels.size()) return false;
+    for (size_t i = 0; i < bodies.size(); i++) {
+        if (bodies[i]->getModelMatrix() != lastBodyModels[i]) return false;
+    }
+    return true;
 }
 
 void Renderer3D::resize(int width, int height) {
     screenWidth = width;
     screenHeight = height;
     rasterizer->resize(width, height);
+    createFrameTexture();
+    fullRedrawPending = true;
 }
 
 void Renderer3D::render(SolarSystem* solarSystem, Camera* camera) {
+    PROFILE_SCOPE("Renderer3D::render");
+    
+    // Plage de profondeur de la caméra (Z inversé)
+    rasterizer->setDepthRange(camera->getNearPlane(), camera->getFarPlane());
+    
+    frameRedraw = updateDirtyRects(solarSystem, camera);
+    if (frameRedraw == FrameRedraw::FULL) {
+        rasterizer->clear();
+    } else {
+        rasterizer->resetFrameStats();
+    }
+    
+    // Culling, tri et LOD une fois par frame, quel que soit le nombre de zones
+    // (rien à préparer si aucune zone n'est à redessiner)
+    Uint64 stageNs[Hud::STAGE_COUNT] = {};
+    if (frameRedraw != FrameRedraw::NONE) {
+        prepareScene(solarSystem, camera, stageNs);
+    }
+    
+    if (frameRedraw == FrameRedraw::FULL) {
+        renderScene(solarSystem, stageNs);
+    } else {
+        // Redessin partiel : chaque zone est effacée puis la scène préparée y
+        // est rejouée, le reste du framebuffer est celui de la frame précédente
+        for (const ScreenRect& rect : dirtyRects) {
+            rasterizer->setScissor(rect);
+            rasterizer->clearRect(rect);
+            renderScene(solarSystem, stageNs);
+        }
+        rasterizer->resetScissor();
+    }
+    
+    hud->addStageTime(Hud::STAGE_STARS, stageNs[Hud::STAGE_STARS] / 1e6);
+    hud->addStageTime(Hud::STAGE_BODIES, stageNs[Hud::STAGE_BODIES] / 1e6);
+    hud->addStageTime(Hud::STAGE_ORBITS, stageNs[Hud::STAGE_ORBITS] / 1e6);
+}
+
+void Renderer3D::prepareScene(SolarSystem* solarSystem, Camera* camera, Uint64* stageNs) {
+    PROFILE_SCOPE("Renderer3D::prepareScene");
+    
+    // Étoiles des cellules visibles du StarSky
+    Uint64 start = Profiler::now();
+    visibleStars.clear();
+    if (showStars) {
+        rasterizer->projectSky(*starSky, camera->getViewMatrix(), camera->getProjectionMatrix(),
+                               visibleStars);
+    }
+    Uint64 starsEnd = Profiler::now();
+    
+    // Corps et orbites visibles
+    solarSystem->prepareDraw(rasterizer, camera);
+    Uint64 bodiesEnd = Profiler::now();
+    
+    stageNs[Hud::STAGE_STARS] += starsEnd - start;
+    stageNs[Hud::STAGE_BODIES] += bodiesEnd - starsEnd;
+}
+
+void Renderer3D::renderScene(SolarSystem* solarSystem, Uint64* stageNs) {
     // 1. Fond étoilé
-    renderStars(camera);
+    Uint64 start = Profiler::now();
+    rasterizer->drawSky(visibleStars);
+    Uint64 starsEnd = Profiler::now();
+    
+    // 2. Corps célestes
+    solarSystem->draw(rasterizer);
+    Uint64 bodiesEnd = Profiler::now();
     
-    // 2. Orbites
+    // 3. Orbites, après les corps : testées contre leur profondeur
     if (showOrbits) {
-        solarSystem->drawOrbits(sdlRenderer, camera, screenWidth, screenHeight);
+        solarSystem->drawOrbits(rasterizer);
+    }
+    Uint64 orbitsEnd = Profiler::now();
+    
+    stageNs[Hud::STAGE_STARS] += starsEnd - start;
+    stageNs[Hud::STAGE_BODIES] += bodiesEnd - starsEnd;
+    stageNs[Hud::STAGE_ORBITS] += orbitsEnd - bodiesEnd;
+}
+
+FrameRedraw Renderer3D::updateDirtyRects(SolarSystem* solarSystem, Camera* camera) {
+    const std::vector<CelestialBody*>& bodies = solarSystem->getBodies();
+    Matrix4x4 view = camera->getViewMatrix();
+    Matrix4x4 projection = camera->getProjectionMatrix();
+    Matrix4x4 viewProjection = camera->getViewProjectionMatrix();
+    Frustum frustum = camera->getFrustum();
+    
+    // Caméra, réglages ou scène modifiés : tout redessiner
+    bool full = !incrementalRedraw || fullRedrawPending ||
+                viewProjection != lastViewProjection ||
+                rasterizer->getSettingsRevision() != lastSettingsRevision ||
+                bodies.size() != lastBodyModels.size();
+    
+    lastViewProjection = viewProjection;
+    lastSettingsRevision = rasterizer->getSettingsRevision();
+    fullRedrawPending = false;
+    lastBodyModels.resize(bodies.size());
+    lastBodyRects.resize(bodies.size(), ScreenRect{0, 0, -1, -1});
+    dirtyRects.clear();
+    
+    const int margin = Constants::DIRTY_RECT_MARGIN;
+    for (size_t i = 0; i < bodies.size(); i++) {
+        CelestialBody* body = bodies[i];
+        
+        // Rectangle écran actuel (vide si hors champ)
+        ScreenRect rect = {0, 0, -1, -1};
+        if (frustum.intersectsSphere(body->getPosition(), body->getBoundingRadius())) {
+            float minDepth;
+            if (!rasterizer->projectSphereBounds(body->getPosition(), body->getBoundingRadius(),
+                                                 view, projection, rect, minDepth)) {
+                // Corps contre le plan proche : pas de rectangle fiable
+                full = true;
+            }
+        }
+        
+        Matrix4x4 model = body->getModelMatrix();
+        if (!full && model != lastBodyModels[i]) {
+            // Union de l'ancienne et de la nouvelle position
+            ScreenRect previous = lastBodyRects[i];
+            ScreenRect area = rect;
+            if (previous.x0 <= previous.x1) {
+                if (area.x0 > area.x1) {
+                    area = previous;
+                } else {
+                    area.x0 = std::min(area.x0, previous.x0);
+                    area.y0 = std::min(area.y0, previous.y0);
+                    area.x1 = std::max(area.x1, previous.x1);
+                    area.y1 = std::max(area.y1, previous.y1);
+                }
+            }
+            if (area.x0 <= area.x1) {
+                dirtyRects.push_back({area.x0 - margin, area.y0 - margin,
+                                      area.x1 + margin, area.y1 + margin});
+            }
+        }
+        
+        lastBodyModels[i] = model;
+        lastBodyRects[i] = rect;
+    }
+    
+    if (full) {
+        dirtyRects.clear();
+        return FrameRedraw::FULL;
+    }
+    
+    // Limiter à l'écran et retirer les zones vides
+    std::vector<ScreenRect> rects;
+    for (ScreenRect rect : dirtyRects) {
+        rect.x0 = std::max(0, rect.x0);
+        rect.y0 = std::max(0, rect.y0);
+        rect.x1 = std::min(screenWidth - 1, rect.x1);
+        rect.y1 = std::min(screenHeight - 1, rect.y1);
+        if (rect.x0 <= rect.x1 && rect.y0 <= rect.y1) {
+            rects.push_back(rect);
+        }
     }
     
-    // 3. Corps célestes
-    solarSystem->draw(rasterizer, camera);
+    // Fusionner les zones qui se chevauchent (chaque pixel redessiné une fois)
+    bool merged = true;
+    while (merged) {
+        merged = false;
+        for (size_t a = 0; a < rects.size() && !merged; a++) {
+            for (size_t b = a + 1; b < rects.size(); b++) {
+                if (rects[a].x0 <= rects[b].x1 && rects[a].x1 >= rects[b].x0 &&
+                    rects[a].y0 <= rects[b].y1 && rects[a].y1 >= rects[b].y0) {
+                    rects[a].x0 = std::min(rects[a].x0, rects[b].x0);
+                    rects[a].y0 = std::min(rects[a].y0, rects[b].y0);
+                    rects[a].x1 = std::max(rects[a].x1, rects[b].x1);
+                    rects[a].y1 = std::max(rects[a].y1, rects[b].y1);
+                    rects.erase(rects.begin() + b);
+                    merged = true;
+                    break;
+                }
+            }
+        }
+    }
+    
+    // Trop de surface : un redessin complet coûte moins cher que plusieurs passes
+    long long area = 0;
+    for (const ScreenRect& rect : rects) {
+        area += (long long)(rect.x1 - rect.x0 + 1) * (rect.y1 - rect.y0 + 1);
+    }
+    if (area > Constants::DIRTY_RECT_MAX_COVERAGE * screenWidth * screenHeight) {
+        dirtyRects.clear();
+        return FrameRedraw::FULL;
+    }
+    
+    // Aucun corps visible n'a bougé : le framebuffer est déjà à jour
+    dirtyRects = rects;
+    return rects.empty() ? FrameRedraw::NONE : FrameRedraw::PARTIAL;
 }
 
 void Renderer3D::renderInfo(int fps, int triangles, float simSpeed, CelestialBody* selectedBody) {
-    if (!showInfo) return;
-    
-    // Dessiner un fond semi-transparent pour le texte
-    SDL_SetRenderDrawColor(sdlRenderer, 0, 0, 0, 180);
-    SDL_FRect bgRect = {10, 10, 250, 120};
-    SDL_RenderFillRect(sdlRenderer, &bgRect);
-    
-    // Bordure
-    SDL_SetRenderDrawColor(sdlRenderer, 0, 255, 0, 255);
-    SDL_RenderRect(sdlRenderer, &bgRect);
-    
-    // Note: Pour afficher du texte, il faudrait SDL_ttf ou dessiner caractère par caractère
-    // Pour ce projet, on affiche juste des indicateurs visuels
-    
-    // Indicateur FPS (barre colorée)
-    float fpsRatio = fps / 60.0f;
-    if (fpsRatio > 1.0f) fpsRatio = 1.0f;
-    
-    Uint8 green = (Uint8)(255 * fpsRatio);
-    Uint8 red = (Uint8)(255 * (1.0f - fpsRatio));
-    SDL_SetRenderDrawColor(sdlRenderer, red, green, 0, 255);
-    SDL_FRect fpsBar = {20, 20, 230 * fpsRatio, 10};
-    SDL_RenderFillRect(sdlRenderer, &fpsBar);
-    
-    // Indicateur triangles (barre)
-    float triRatio = triangles / 3000.0f;
-    if (triRatio > 1.0f) triRatio = 1.0f;
-    
-    SDL_SetRenderDrawColor(sdlRenderer, 100, 200, 255, 255);
-    SDL_FRect triBar = {20, 40, 230 * triRatio, 10};
-    SDL_RenderFillRect(sdlRenderer, &triBar);
-    
-    // Indicateur vitesse simulation
-    float speedRatio = simSpeed / Constants::MAX_SIMULATION_SPEED;
-    SDL_SetRenderDrawColor(sdlRenderer, 255, 200, 0, 255);
-    SDL_FRect speedBar = {20, 60, 230 * speedRatio, 10};
-    SDL_RenderFillRect(sdlRenderer, &speedBar);
-    
-    // Points pour représenter les valeurs
-    for (int i = 0; i < 5; i++) {
-        SDL_SetRenderDrawColor(sdlRenderer, 0, 255, 0, 255);
-        SDL_FRect dot = {20.0f + i * 50, 80, 5, 5};
-        SDL_RenderFillRect(sdlRenderer, &dot);
+    (void)selectedBody;
+    
+    if (!showInfo) {
+        // Les mesures reprennent à zéro quand le panneau réapparaît
+        hud->discardWindow();
+        lastInfoTime = 0;
+        hudBackgroundValid = false;
+        return;
+    }
+    PROFILE_SCOPE("Renderer3D::renderInfo");
+    
+    // Durée de frame = intervalle entre deux panneaux
+    Uint64 now = Profiler::now();
+    double frameMs;
+    if (nominalTimings) {
+        frameMs = 1000.0 / std::max(1, fps);
+    } else {
+        frameMs = lastInfoTime ? (now - lastInfoTime) / 1e6 : 0.0;
     }
+    lastInfoTime = now;
+    
+    bool layerChanged = hud->endFrame(frameMs, fps, triangles,
+                                      rasterizer->getFrameCulledTriangleCount(),
+                                      simSpeed, !nominalTimings);
+    composeHud(layerChanged);
 }
 
-void Renderer3D::drawText(const std::string& text, int x, int y) {
-    // Fonction placeholder pour le texte
-    // Dans un vrai projet, utiliser SDL_ttf
-    (void)text;
-    (void)x;
-    (void)y;
+void Renderer3D::composeHud(bool layerChanged) {
+    const int x = Constants::HUD_X;
+    const int y = Constants::HUD_Y;
+    const int w = hud->getWidth();
+    ScreenRect area = {x, y, std::min(x + w, screenWidth) - 1,
+                       std::min(y + hud->getHeight(), screenHeight) - 1};
+    if (area.x0 > area.x1 || area.y0 > area.y1) return;
+    
+    // Zones du panneau où la scène vient d'être redessinée. Ailleurs, le
+    // framebuffer contient déjà le panneau de la frame précédente : il ne
+    // doit pas être recopié dans hudBackground, ni recomposé par-dessus.
+    bool full = frameRedraw == FrameRedraw::FULL || !hudBackgroundValid;
+    std::vector<ScreenRect> fresh;
+    if (full) {
+        fresh.push_back(area);
+    } else {
+        for (const ScreenRect& rect : dirtyRects) {
+            ScreenRect part = {std::max(area.x0, rect.x0), std::max(area.y0, rect.y0),
+                               std::min(area.x1, rect.x1), std::min(area.y1, rect.y1)};
+            if (part.x0 <= part.x1 && part.y0 <= part.y1) {
+                fresh.push_back(part);
+            }
+        }
+    }
+    
+    const Uint32* color = rasterizer->getColorBuffer();
+    for (const ScreenRect& rect : fresh) {
+        for (int py = rect.y0; py <= rect.y1; py++) {
+            std::memcpy(&hudBackground[(py - y) * w + rect.x0 - x],
+                        color + py * screenWidth + rect.x0,
+                        (rect.x1 - rect.x0 + 1) * sizeof(Uint32));
+        }
+    }
+    hudBackgroundValid = true;
+    
+    if (full || layerChanged) {
+        rasterizer->blendImage(x, y, w, hud->getHeight(), hud->getLayer(), hudBackground.data());
+        if (frameRedraw != FrameRedraw::FULL) {
+            // Panneau à envoyer par present(), même sans autre zone redessinée
+            dirtyRects.push_back(area);
+            frameRedraw = FrameRedraw::PARTIAL;
+        }
+        return;
+    }
+    
+    for (const ScreenRect& rect : fresh) {
+        rasterizer->setScissor(rect);
+        rasterizer->blendImage(x, y, w, hud->getHeight(), hud->getLayer(), hudBackground.data());
+    }
+    rasterizer->resetScissor();
 }
\ No newline at end of file
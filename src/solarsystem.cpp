@@ -1,8 +1,22 @@
-#include "SolarSystem.h"
-#include "Constants.h"
+#include "solarsystem.h"
+#include "constants.h"
+#include "profiler.h"
+#include <algorithm>
 #include <cmath>
 
-SolarSystem::SolarSystem() : sun(nullptr) {}
+SolarSystem::SolarSystem() : sun(nullptr), culledBodyCount(0) {
+    // Cercles unité des orbites, de ORBIT_MIN_SEGMENTS points en doublant
+    orbitCircles.resize(Constants::ORBIT_LEVELS);
+    for (int level = 0; level < Constants::ORBIT_LEVELS; level++) {
+        int segments = Constants::ORBIT_MIN_SEGMENTS << level;
+        std::vector<Vector3D>& circle = orbitCircles[level];
+        circle.resize(segments);
+        for (int i = 0; i < segments; i++) {
+            float angle = i * Constants::TWO_PI / segments;
+            circle[i] = Vector3D(std::cos(angle), 0.0f, std::sin(angle));
+        }
+    }
+}
 
 SolarSystem::~SolarSystem() {
     for (auto body : bodies) {
@@ -65,69 +79,147 @@ void SolarSystem::initialize() {
     ));
 }
 
+void SolarSystem::addBody(CelestialBody* body) {
+    bodies.push_back(body);
+}
+
 void SolarSystem::update(float deltaTime) {
+    PROFILE_SCOPE("SolarSystem::update");
+    
     for (auto body : bodies) {
         body->update(deltaTime);
     }
 }
 
-void SolarSystem::draw(Rasterizer* rasterizer, Camera* camera) {
-    Matrix4x4 view = camera->getViewMatrix();
-    Matrix4x4 projection = camera->getProjectionMatrix();
+void SolarSystem::prepareDraw(Rasterizer* rasterizer, Camera* camera) {
+    PROFILE_SCOPE("SolarSystem::prepareDraw");
     
-    // Dessiner chaque corps céleste
-    for (auto body : bodies) {
-        Matrix4x4 model = body->getModelMatrix();
+    drawView = camera->getViewMatrix();
+    drawProjection = camera->getProjectionMatrix();
+    Matrix4x4 viewProj = camera->getViewProjectionMatrix();
+    Frustum frustum = camera->getFrustum();
+    
+    // Du plus proche au plus lointain : les corps proches remplissent le
+    // Z-Buffer d'abord, les corps cachés peuvent alors être rejetés en entier
+    Vector3D eye = camera->getPosition();
+    std::vector<CelestialBody*> sorted = bodies;
+    std::sort(sorted.begin(), sorted.end(), [&eye](CelestialBody* a, CelestialBody* b) {
+        return a->getPosition().distanceSquared(eye) < b->getPosition().distanceSquared(eye);
+    });
+    
+    culledBodyCount = 0;
+    visibleBodies.clear();
+    
+    for (auto body : sorted) {
+        // Frustum culling : corps derrière la caméra ou hors écran
+        if (!frustum.intersectsSphere(body->getPosition(), body->getBoundingRadius())) {
+            culledBodyCount++;
+            continue;
+        }
         
-        rasterizer->drawMesh(
-            body->getMesh(),
-            model,
-            view,
-            projection,
-            body->getColor()
-        );
+        BodyDraw item;
+        item.body = body;
+        item.bounded = rasterizer->projectSphereBounds(body->getPosition(), body->getBoundingRadius(),
+                                                       drawView, drawProjection,
+                                                       item.bounds, item.minDepth);
+        
+        // Niveau de détail d'après la taille à l'écran
+        if (!rasterizer->isImpostorMode() || rasterizer->isWireframeMode()) {
+            body->selectLod(camera->getProjectedRadius(body->getPosition(),
+                                                       body->getBoundingRadius(),
+                                                       rasterizer->getHeight()));
+            item.model = body->getModelMatrix();
+        }
+        visibleBodies.push_back(item);
     }
-}
-
-void SolarSystem::drawOrbits(SDL_Renderer* renderer, Camera* camera, int screenWidth, int screenHeight) {
-    Matrix4x4 viewProj = camera->getViewProjectionMatrix();
     
-    SDL_SetRenderDrawColor(renderer, 
-                          Constants::ORBIT_COLOR.r, 
-                          Constants::ORBIT_COLOR.g, 
-                          Constants::ORBIT_COLOR.b, 
-                          Constants::ORBIT_COLOR.a);
+    // Orbites : l'orbite tient dans la sphère centrée sur le soleil de même rayon
+    Vector3D center(0.0f, 0.0f, 0.0f);
+    visibleOrbits.clear();
     
-    // Dessiner l'orbite de chaque planète
     for (const auto& body : bodies) {
         if (body->getIsSun()) continue;
         
         float radius = body->getOrbitalRadius();
-        int segments = 128;
+        if (!frustum.intersectsSphere(center, radius)) continue;
         
-        for (int i = 0; i < segments; i++) {
-            float angle1 = i * Constants::TWO_PI / segments;
-            float angle2 = (i + 1) * Constants::TWO_PI / segments;
-            
-            Vector3D p1(std::cos(angle1) * radius, 0.0f, std::sin(angle1) * radius);
-            Vector3D p2(std::cos(angle2) * radius, 0.0f, std::sin(angle2) * radius);
-            
-            Vector3D proj1 = viewProj.transformPoint(p1);
-            Vector3D proj2 = viewProj.transformPoint(p2);
-            
-            // Convertir en coordonnées écran
-            float x1 = (proj1.x + 1.0f) * 0.5f * screenWidth;
-            float y1 = (1.0f - proj1.y) * 0.5f * screenHeight;
-            float x2 = (proj2.x + 1.0f) * 0.5f * screenWidth;
-            float y2 = (1.0f - proj2.y) * 0.5f * screenHeight;
-            
-            // Clip test basique
-            if (x1 >= 0 && x1 < screenWidth && y1 >= 0 && y1 < screenHeight &&
-                x2 >= 0 && x2 < screenWidth && y2 >= 0 && y2 < screenHeight) {
-                SDL_RenderLine(renderer, x1, y1, x2, y2);
-            }
+        OrbitDraw orbit;
+        float minDepth;
+        orbit.bounded = rasterizer->projectSphereBounds(center, radius, drawView, drawProjection,
+                                                        orbit.bounds, minDepth);
+        orbit.level = selectOrbitLevel(camera->getProjectedRadius(center, radius,
+                                                                  rasterizer->getHeight()));
+        orbit.mvp = viewProj * body->getOrbitMatrix();
+        visibleOrbits.push_back(orbit);
+    }
+}
+
+void SolarSystem::draw(Rasterizer* rasterizer) {
+    PROFILE_SCOPE("SolarSystem::draw");
+    
+    for (const BodyDraw& item : visibleBodies) {
+        // Redessin partiel : corps hors de la zone à redessiner
+        if (item.bounded && !rasterizer->intersectsScissor(item.bounds)) {
+            continue;
+        }
+        
+        // Rejet précoce par le Hierarchical Z, sur un Z-Buffer à jour : les
+        // triangles en attente sous ce corps sont rasterisés d'abord
+        if (item.bounded) {
+            rasterizer->flushOverlapping(item.bounds);
         }
+        if (item.bounded && rasterizer->isOccluded(item.bounds, item.minDepth)) {
+            rasterizer->countRejectedBody();
+            continue;
+        }
+        
+        CelestialBody* body = item.body;
+        
+        // Imposteur analytique : pas de triangles du tout
+        if (rasterizer->isImpostorMode() && !rasterizer->isWireframeMode()) {
+            rasterizer->drawSphereImpostor(body->getPosition(), body->getVisualRadius(),
+                                           drawView, drawProjection, body->getColor());
+            continue;
+        }
+        
+        rasterizer->drawMesh(
+            body->getMesh(),
+            item.model,
+            drawView,
+            drawProjection,
+            body->getColor()
+        );
     }
+    
+    // Rasteriser les tuiles en parallèle
+    rasterizer->flush();
+}
+
+void SolarSystem::drawOrbits(Rasterizer* rasterizer) {
+    PROFILE_SCOPE("SolarSystem::drawOrbits");
+    
+    // Dessiner l'orbite de chaque planète (polyligne fermée, cachée
+    // par les corps déjà dessinés devant elle)
+    for (const OrbitDraw& orbit : visibleOrbits) {
+        if (orbit.bounded && !rasterizer->intersectsScissor(orbit.bounds)) {
+            continue;
+        }
+        
+        const std::vector<Vector3D>& circle = orbitCircles[orbit.level];
+        rasterizer->drawPolyline(circle.data(), (int)circle.size(), true,
+                                 orbit.mvp, Constants::ORBIT_COLOR, true);
+    }
+}
+
+int SolarSystem::selectOrbitLevel(float screenRadius) const {
+    // Assez de segments pour que chacun fasse ~ORBIT_SEGMENT_PIXELS de long
+    float wanted = Constants::TWO_PI * screenRadius / Constants::ORBIT_SEGMENT_PIXELS;
+    int level = 0;
+    while (level < Constants::ORBIT_LEVELS - 1 &&
+           (float)(Constants::ORBIT_MIN_SEGMENTS << level) < wanted) {
+        level++;
+    }
+    return level;
 }
 
 const std::vector<CelestialBody*>& SolarSystem::getBodies() const {
@@ -144,4 +236,8 @@ int SolarSystem::getTotalTriangleCount() const {
         total += body->getMesh()->getTriangleCount();
     }
     return total;
+}
+
+int SolarSystem::getCulledBodyCount() const {
+    return culledBodyCount;
 }
\ No newline at end of file
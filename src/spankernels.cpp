@@ -0,0 +1,318 @@
+#include "spankernels.h"
+#include <algorithm>
+
+#if defined(__x86_64__) || defined(_M_X64) || defined(__i386__) || defined(_M_IX86)
+#define SPAN_KERNELS_X86 1
+#include <immintrin.h>
+#endif
+
+// GCC/Clang : compiler les fonctions AVX2 sans imposer -mavx2 à tout le projet
+#if defined(__GNUC__) || defined(__clang__)
+#define TARGET_AVX2 __attribute__((target("avx2")))
+#else
+#define TARGET_AVX2
+#endif
+
+namespace SpanKernels {
+
+// Échelles de quantification des formats entiers
+static const float UNORM24_SCALE = 16777215.0f;
+static const float UNORM16_SCALE = 65535.0f;
+
+// ======================
+// SCALAIRE
+// ======================
+
+/**
+ * @brief Profondeur [0, 1] -> entier arrondi, saturé à scale
+ * 
+ * Mêmes opérations flottantes que les versions SIMD (résultats identiques).
+ */
+static inline Uint32 quantize(float z, float scale) {
+    float q = std::max(z, 0.0f) * scale + 0.5f;
+    return (Uint32)std::min(q, scale);
+}
+
+// Chaque noyau calcule la profondeur du pixel i comme z + dzdx * i, à partir
+// du début du span : les versions SIMD font exactement les mêmes opérations
+// (z + (i + voie) * dzdx) et délèguent leur reste à ces boucles avec first,
+// pour que les égalités de profondeur et la quantification UNORM ne
+// dépendent pas du niveau choisi.
+
+static void depthSpanScalarFrom(float* depth, Uint32* color, int first, int count,
+                                float z, float dzdx, Uint32 pixel) {
+    for (int i = first; i < count; i++) {
+        float zi = z + dzdx * i;
+        if (zi < depth[i]) {
+            depth[i] = zi;
+            color[i] = pixel;
+        }
+    }
+}
+
+static void unorm24SpanScalarFrom(Uint32* depth, Uint32* color, int first, int count,
+                                  float z, float dzdx, Uint32 pixel, Uint32 tag) {
+    for (int i = first; i < count; i++) {
+        Uint32 zi = tag | quantize(z + dzdx * i, UNORM24_SCALE);
+        if (zi < depth[i]) {
+            depth[i] = zi;
+            color[i] = pixel;
+        }
+    }
+}
+
+static void unorm16SpanScalarFrom(Uint16* depth, Uint32* color, int first, int count,
+                                  float z, float dzdx, Uint32 pixel) {
+    for (int i = first; i < count; i++) {
+        Uint16 zi = (Uint16)quantize(z + dzdx * i, UNORM16_SCALE);
+        if (zi < depth[i]) {
+            depth[i] = zi;
+            color[i] = pixel;
+        }
+    }
+}
+
+static void depthSpanScalar(float* depth, Uint32* color, int count,
+                            float z, float dzdx, Uint32 pixel) {
+    depthSpanScalarFrom(depth, color, 0, count, z, dzdx, pixel);
+}
+
+static void unorm24SpanScalar(Uint32* depth, Uint32* color, int count,
+                              float z, float dzdx, Uint32 pixel, Uint32 tag) {
+    unorm24SpanScalarFrom(depth, color, 0, count, z, dzdx, pixel, tag);
+}
+
+static void unorm16SpanScalar(Uint16* depth, Uint32* color, int count,
+                              float z, float dzdx, Uint32 pixel) {
+    unorm16SpanScalarFrom(depth, color, 0, count, z, dzdx, pixel);
+}
+
+#ifdef SPAN_KERNELS_X86
+
+// ======================
+// SSE2 (4 pixels)
+// ======================
+
+static void depthSpanSSE2(float* depth, Uint32* color, int count,
+                          float z, float dzdx, Uint32 pixel) {
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 vz0 = _mm_set1_ps(z);
+    const __m128 vdzdx = _mm_set1_ps(dzdx);
+    const __m128i vpixel = _mm_set1_epi32((int)pixel);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 vz = _mm_add_ps(vz0, _mm_mul_ps(_mm_add_ps(_mm_set1_ps((float)i), lanes), vdzdx));
+        __m128 old = _mm_loadu_ps(depth + i);
+        __m128 mask = _mm_cmplt_ps(vz, old);
+
+        // Sélection sans branche : mask ? nouveau : ancien
+        __m128 newDepth = _mm_or_ps(_mm_and_ps(mask, vz), _mm_andnot_ps(mask, old));
+        _mm_storeu_ps(depth + i, newDepth);
+
+        __m128i imask = _mm_castps_si128(mask);
+        __m128i oldColor = _mm_loadu_si128((const __m128i*)(color + i));
+        __m128i newColor = _mm_or_si128(_mm_and_si128(imask, vpixel),
+                                        _mm_andnot_si128(imask, oldColor));
+        _mm_storeu_si128((__m128i*)(color + i), newColor);
+    }
+
+    depthSpanScalarFrom(depth, color, i, count, z, dzdx, pixel);
+}
+
+static inline __m128i quantizeSSE2(__m128 z, __m128 scale) {
+    __m128 q = _mm_add_ps(_mm_mul_ps(_mm_max_ps(z, _mm_setzero_ps()), scale), _mm_set1_ps(0.5f));
+    return _mm_cvttps_epi32(_mm_min_ps(q, scale));
+}
+
+static void unorm24SpanSSE2(Uint32* depth, Uint32* color, int count,
+                            float z, float dzdx, Uint32 pixel, Uint32 tag) {
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 vz0 = _mm_set1_ps(z);
+    const __m128 vdzdx = _mm_set1_ps(dzdx);
+    const __m128 scale = _mm_set1_ps(UNORM24_SCALE);
+    const __m128i vtag = _mm_set1_epi32((int)tag);
+    const __m128i vpixel = _mm_set1_epi32((int)pixel);
+    // SSE2 ne compare qu'en signé : décaler de 2^31 les deux opérandes
+    const __m128i bias = _mm_set1_epi32((int)0x80000000u);
+
+    int i = 0;
+    for (; i + 4 <= count; i += 4) {
+        __m128 vz = _mm_add_ps(vz0, _mm_mul_ps(_mm_add_ps(_mm_set1_ps((float)i), lanes), vdzdx));
+        __m128i newDepth = _mm_or_si128(vtag, quantizeSSE2(vz, scale));
+        __m128i old = _mm_loadu_si128((const __m128i*)(depth + i));
+        __m128i mask = _mm_cmplt_epi32(_mm_xor_si128(newDepth, bias), _mm_xor_si128(old, bias));
+
+        _mm_storeu_si128((__m128i*)(depth + i),
+                         _mm_or_si128(_mm_and_si128(mask, newDepth), _mm_andnot_si128(mask, old)));
+
+        __m128i oldColor = _mm_loadu_si128((const __m128i*)(color + i));
+        _mm_storeu_si128((__m128i*)(color + i),
+                         _mm_or_si128(_mm_and_si128(mask, vpixel), _mm_andnot_si128(mask, oldColor)));
+    }
+
+    unorm24SpanScalarFrom(depth, color, i, count, z, dzdx, pixel, tag);
+}
+
+static void unorm16SpanSSE2(Uint16* depth, Uint32* color, int count,
+                            float z, float dzdx, Uint32 pixel) {
+    const __m128 lanes = _mm_set_ps(3.0f, 2.0f, 1.0f, 0.0f);
+    const __m128 vz0 = _mm_set1_ps(z);
+    const __m128 vdzdx = _mm_set1_ps(dzdx);
+    const __m128 scale = _mm_set1_ps(UNORM16_SCALE);
+    const __m128i vpixel = _mm_set1_epi32((int)pixel);
+    // Comparaison 16 bits signée : passer de [0, 65535] à [-32768, 32767]
+    const __m128i bias32 = _mm_set1_epi32(32768);
+    const __m128i bias16 = _mm_set1_epi16((short)0x8000);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m128 z0 = _mm_add_ps(vz0, _mm_mul_ps(_mm_add_ps(_mm_set1_ps((float)i), lanes), vdzdx));
+        __m128 z1 = _mm_add_ps(vz0, _mm_mul_ps(_mm_add_ps(_mm_set1_ps((float)(i + 4)), lanes), vdzdx));
+        __m128i newDepth = _mm_packs_epi32(_mm_sub_epi32(quantizeSSE2(z0, scale), bias32),
+                                           _mm_sub_epi32(quantizeSSE2(z1, scale), bias32));
+        __m128i old = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(depth + i)), bias16);
+        __m128i mask = _mm_cmplt_epi16(newDepth, old);
+
+        __m128i merged = _mm_or_si128(_mm_and_si128(mask, newDepth), _mm_andnot_si128(mask, old));
+        _mm_storeu_si128((__m128i*)(depth + i), _mm_xor_si128(merged, bias16));
+
+        // Masque 16 bits -> deux masques 32 bits pour les couleurs
+        __m128i maskLo = _mm_unpacklo_epi16(mask, mask);
+        __m128i maskHi = _mm_unpackhi_epi16(mask, mask);
+        __m128i colorLo = _mm_loadu_si128((const __m128i*)(color + i));
+        __m128i colorHi = _mm_loadu_si128((const __m128i*)(color + i + 4));
+        _mm_storeu_si128((__m128i*)(color + i),
+                         _mm_or_si128(_mm_and_si128(maskLo, vpixel), _mm_andnot_si128(maskLo, colorLo)));
+        _mm_storeu_si128((__m128i*)(color + i + 4),
+                         _mm_or_si128(_mm_and_si128(maskHi, vpixel), _mm_andnot_si128(maskHi, colorHi)));
+    }
+
+    unorm16SpanScalarFrom(depth, color, i, count, z, dzdx, pixel);
+}
+
+// ======================
+// AVX2 (8 pixels)
+// ======================
+
+TARGET_AVX2
+static void depthSpanAVX2(float* depth, Uint32* color, int count,
+                          float z, float dzdx, Uint32 pixel) {
+    const __m256 lanes = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    const __m256 vz0 = _mm256_set1_ps(z);
+    const __m256 vdzdx = _mm256_set1_ps(dzdx);
+    const __m256 vpixel = _mm256_castsi256_ps(_mm256_set1_epi32((int)pixel));
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 vz = _mm256_add_ps(vz0, _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps((float)i), lanes), vdzdx));
+        __m256 old = _mm256_loadu_ps(depth + i);
+        __m256 mask = _mm256_cmp_ps(vz, old, _CMP_LT_OQ);
+
+        _mm256_storeu_ps(depth + i, _mm256_blendv_ps(old, vz, mask));
+
+        __m256 oldColor = _mm256_loadu_ps((const float*)(color + i));
+        _mm256_storeu_ps((float*)(color + i), _mm256_blendv_ps(oldColor, vpixel, mask));
+    }
+
+    depthSpanScalarFrom(depth, color, i, count, z, dzdx, pixel);
+}
+
+TARGET_AVX2
+static void unorm24SpanAVX2(Uint32* depth, Uint32* color, int count,
+                            float z, float dzdx, Uint32 pixel, Uint32 tag) {
+    const __m256 lanes = _mm256_set_ps(7.0f, 6.0f, 5.0f, 4.0f, 3.0f, 2.0f, 1.0f, 0.0f);
+    const __m256 vz0 = _mm256_set1_ps(z);
+    const __m256 vdzdx = _mm256_set1_ps(dzdx);
+    const __m256 scale = _mm256_set1_ps(UNORM24_SCALE);
+    const __m256i vtag = _mm256_set1_epi32((int)tag);
+    const __m256i vpixel = _mm256_set1_epi32((int)pixel);
+    const __m256i bias = _mm256_set1_epi32((int)0x80000000u);
+
+    int i = 0;
+    for (; i + 8 <= count; i += 8) {
+        __m256 vz = _mm256_add_ps(vz0, _mm256_mul_ps(_mm256_add_ps(_mm256_set1_ps((float)i), lanes), vdzdx));
+        __m256 q = _mm256_add_ps(_mm256_mul_ps(_mm256_max_ps(vz, _mm256_setzero_ps()), scale),
+                                 _mm256_set1_ps(0.5f));
+        __m256i newDepth = _mm256_or_si256(vtag, _mm256_cvttps_epi32(_mm256_min_ps(q, scale)));
+        __m256i old = _mm256_loadu_si256((const __m256i*)(depth + i));
+        __m256i mask = _mm256_cmpgt_epi32(_mm256_xor_si256(old, bias), _mm256_xor_si256(newDepth, bias));
+
+        _mm256_storeu_si256((__m256i*)(depth + i), _mm256_blendv_epi8(old, newDepth, mask));
+
+        __m256i oldColor = _mm256_loadu_si256((const __m256i*)(color + i));
+        _mm256_storeu_si256((__m256i*)(color + i), _mm256_blendv_epi8(oldColor, vpixel, mask));
+    }
+
+    unorm24SpanScalarFrom(depth, color, i, count, z, dzdx, pixel, tag);
+}
+
+#endif // SPAN_KERNELS_X86
+
+// ======================
+// SÉLECTION
+// ======================
+
+Level detect() {
+#ifdef SPAN_KERNELS_X86
+    if (SDL_HasAVX2()) return Level::AVX2;
+    if (SDL_HasSSE2()) return Level::SSE2;
+#endif
+    return Level::SCALAR;
+}
+
+DepthSpanFunc get(Level level) {
+#ifdef SPAN_KERNELS_X86
+    switch (level) {
+        case Level::AVX2:
+            return depthSpanAVX2;
+        case Level::SSE2:
+            return depthSpanSSE2;
+        case Level::SCALAR:
+            break;
+    }
+#else
+    (void)level;
+#endif
+    return depthSpanScalar;
+}
+
+Unorm24SpanFunc getUnorm24(Level level) {
+#ifdef SPAN_KERNELS_X86
+    switch (level) {
+        case Level::AVX2:
+            return unorm24SpanAVX2;
+        case Level::SSE2:
+            return unorm24SpanSSE2;
+        case Level::SCALAR:
+            break;
+    }
+#else
+    (void)level;
+#endif
+    return unorm24SpanScalar;
+}
+
+Unorm16SpanFunc getUnorm16(Level level) {
+#ifdef SPAN_KERNELS_X86
+    // Pas de version AVX2 : le pack 16 bits travaille par moitiés de 128 bits
+    if (level != Level::SCALAR) return unorm16SpanSSE2;
+#else
+    (void)level;
+#endif
+    return unorm16SpanScalar;
+}
+
+const char* getName(Level level) {
+    switch (level) {
+        case Level::AVX2:
+            return "AVX2";
+        case Level::SSE2:
+            return "SSE2";
+        case Level::SCALAR:
+            break;
+    }
+    return "Scalaire";
+}
+
+} // namespace SpanKernels
@@ -1,6 +1,7 @@
-#include "Sphere.h"
-#include "Constants.h"
+#include "sphere.h"
+#include "constants.h"
 #include <cmath>
+#include <vector>
 
 
 Sphere::Sphere(float radius, int sectors, int stacks)
@@ -18,6 +19,17 @@ void Sphere::generate() {
     float sectorStep = Constants::TWO_PI / sectors;
     float stackStep = Constants::PI / stacks;
     
+    reserve((sectors + 1) * (stacks + 1), 6 * sectors * (stacks - 1));
+    
+    // cos / sin de chaque longitude, partagés par toutes les rangées
+    std::vector<float> sectorCos(sectors + 1);
+    std::vector<float> sectorSin(sectors + 1);
+    for (int j = 0; j <= sectors; ++j) {
+        float sectorAngle = j * sectorStep;                       // De 0 à 2π
+        sectorCos[j] = std::cos(sectorAngle);
+        sectorSin[j] = std::sin(sectorAngle);
+    }
+    
     // Générer les vertices
     for (int i = 0; i <= stacks; ++i) {
         float stackAngle = Constants::PI / 2.0f - i * stackStep;  // De π/2 à -π/2
@@ -25,23 +37,15 @@ void Sphere::generate() {
         float z = radius * std::sin(stackAngle);                  // r * sin(u)
         
         for (int j = 0; j <= sectors; ++j) {
-            float sectorAngle = j * sectorStep;                   // De 0 à 2π
-            
-            Vertex vertex;
-            
             // Position
-            vertex.position.x = xy * std::cos(sectorAngle);       // r * cos(u) * cos(v)
-            vertex.position.y = xy * std::sin(sectorAngle);       // r * cos(u) * sin(v)
-            vertex.position.z = z;                                // r * sin(u)
-            
-            // Normale (pour une sphère centrée à l'origine)
-            vertex.normal = vertex.position.normalized();
+            Vector3D position(xy * sectorCos[j],                  // r * cos(u) * cos(v)
+                              xy * sectorSin[j],                  // r * cos(u) * sin(v)
+                              z);                                 // r * sin(u)
             
-            // Coordonnées de texture (UV mapping)
-            vertex.u = (float)j / sectors;
-            vertex.v = (float)i / stacks;
-            
-            vertices.push_back(vertex);
+            // Normale (pour une sphère centrée à l'origine) et
+            // coordonnées de texture (UV mapping)
+            addVertex(position, position.normalized(),
+                      (float)j / sectors, (float)i / stacks);
         }
     }
     
@@ -55,19 +59,17 @@ void Sphere::generate() {
             
             // Triangle 1
             if (i != 0) {
-                indices.push_back(k1);
-                indices.push_back(k2);
-                indices.push_back(k1 + 1);
+                addTriangle(k1, k2, k1 + 1);
             }
             
             // Triangle 2
             if (i != (stacks - 1)) {
-                indices.push_back(k1 + 1);
-                indices.push_back(k2);
-                indices.push_back(k2 + 1);
+                addTriangle(k1 + 1, k2, k2 + 1);
             }
         }
     }
+    
+    compactIndices();
 }
 
 void Sphere::setRadius(float r) {
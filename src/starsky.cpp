@@ -0,0 +1,145 @@
+#include "starsky.h"
+#include "constants.h"
+#include <algorithm>
+#include <cmath>
+#include <random>
+
+StarSky::StarSky(int faceSize)
+    : faceSize(faceSize)
+    , cellsPerSide(std::max(1, faceSize / Constants::SKY_CELL_SIZE)) {
+    build();
+}
+
+void StarSky::clear() {
+    catalogDirections.clear();
+    catalogBrightness.clear();
+    build();
+}
+
+void StarSky::addStar(const Vector3D& direction, float brightness) {
+    catalogDirections.push_back(direction.normalized());
+    catalogBrightness.push_back(std::min(std::max(brightness, 0.0f), 1.0f));
+}
+
+int StarSky::texelIndex(const Vector3D& direction, int& cell) const {
+    float ax = std::fabs(direction.x);
+    float ay = std::fabs(direction.y);
+    float az = std::fabs(direction.z);
+    
+    // Face = axe dominant, (u, v) = projection sur cette face
+    int face;
+    float u, v, major;
+    if (ax >= ay && ax >= az) {
+        face = direction.x > 0.0f ? 0 : 1;
+        major = ax; u = direction.z; v = direction.y;
+    } else if (ay >= az) {
+        face = direction.y > 0.0f ? 2 : 3;
+        major = ay; u = direction.x; v = direction.z;
+    } else {
+        face = direction.z > 0.0f ? 4 : 5;
+        major = az; u = direction.x; v = direction.y;
+    }
+    
+    // [-major, major] -> [0, faceSize[
+    float half = 0.5f * faceSize;
+    int i = std::min((int)(u / major * half + half), faceSize - 1);
+    int j = std::min((int)(v / major * half + half), faceSize - 1);
+    
+    int cellSize = faceSize / cellsPerSide;
+    int ci = std::min(i / cellSize, cellsPerSide - 1);
+    int cj = std::min(j / cellSize, cellsPerSide - 1);
+    cell = (face * cellsPerSide + cj) * cellsPerSide + ci;
+    return (face * faceSize + j) * faceSize + i;
+}
+
+Vector3D StarSky::faceDirection(int face, float u, float v) {
+    // Inverse de texelIndex
+    switch (face) {
+        case 0:  return Vector3D(1.0f, v, u);
+        case 1:  return Vector3D(-1.0f, v, u);
+        case 2:  return Vector3D(u, 1.0f, v);
+        case 3:  return Vector3D(u, -1.0f, v);
+        case 4:  return Vector3D(u, v, 1.0f);
+        default: return Vector3D(u, v, -1.0f);
+    }
+}
+
+void StarSky::build() {
+    // Cônes des cellules : axe au centre, rayon jusqu'au coin le plus éloigné
+    cells.assign(6 * cellsPerSide * cellsPerSide, Cell());
+    for (int face = 0; face < 6; face++) {
+        for (int cj = 0; cj < cellsPerSide; cj++) {
+            for (int ci = 0; ci < cellsPerSide; ci++) {
+                float u0 = 2.0f * ci / cellsPerSide - 1.0f;
+                float v0 = 2.0f * cj / cellsPerSide - 1.0f;
+                float u1 = 2.0f * (ci + 1) / cellsPerSide - 1.0f;
+                float v1 = 2.0f * (cj + 1) / cellsPerSide - 1.0f;
+                
+                Cell& cell = cells[(face * cellsPerSide + cj) * cellsPerSide + ci];
+                cell.center = faceDirection(face, 0.5f * (u0 + u1), 0.5f * (v0 + v1)).normalized();
+                cell.cosRadius = 1.0f;
+                for (int k = 0; k < 4; k++) {
+                    Vector3D corner = faceDirection(face, (k & 1) ? u1 : u0, (k & 2) ? v1 : v0);
+                    cell.cosRadius = std::min(cell.cosRadius, corner.normalized().dot(cell.center));
+                }
+                cell.sinRadius = std::sqrt(std::max(0.0f, 1.0f - cell.cosRadius * cell.cosRadius));
+                cell.first = 0;
+                cell.count = 0;
+            }
+        }
+    }
+    
+    // Trier le catalogue par cellule puis texel, la plus brillante d'abord
+    struct Entry {
+        int cell;
+        int texel;
+        int star;
+    };
+    std::vector<Entry> entries(catalogDirections.size());
+    for (size_t s = 0; s < entries.size(); s++) {
+        entries[s].star = (int)s;
+        entries[s].texel = texelIndex(catalogDirections[s], entries[s].cell);
+    }
+    std::sort(entries.begin(), entries.end(), [this](const Entry& a, const Entry& b) {
+        if (a.cell != b.cell) return a.cell < b.cell;
+        if (a.texel != b.texel) return a.texel < b.texel;
+        return catalogBrightness[a.star] > catalogBrightness[b.star];
+    });
+    
+    // Une étoile par texel
+    directions.clear();
+    pixels.clear();
+    for (size_t e = 0; e < entries.size(); e++) {
+        if (e > 0 && entries[e].texel == entries[e - 1].texel) continue;
+        
+        Cell& cell = cells[entries[e].cell];
+        if (cell.count == 0) {
+            cell.first = (int)directions.size();
+        }
+        cell.count++;
+        
+        Uint32 l = (Uint32)(255 * catalogBrightness[entries[e].star]);
+        directions.push_back(catalogDirections[entries[e].star]);
+        pixels.push_back(0xFF000000u | l * 0x010101u);
+    }
+}
+
+void StarSky::generate(int count, unsigned int seed) {
+    catalogDirections.clear();
+    catalogBrightness.clear();
+    
+    std::mt19937 gen(seed);
+    std::uniform_real_distribution<float> heightDist(-1.0f, 1.0f);
+    std::uniform_real_distribution<float> angleDist(0.0f, Constants::TWO_PI);
+    std::uniform_real_distribution<float> brightDist(0.3f, 1.0f);
+    
+    for (int i = 0; i < count; i++) {
+        // Direction uniforme sur la sphère (méthode d'Archimède)
+        float y = heightDist(gen);
+        float angle = angleDist(gen);
+        float r = std::sqrt(1.0f - y * y);
+        addStar(Vector3D(r * std::cos(angle), y, r * std::sin(angle)), brightDist(gen));
+    }
+    
+    build();
+}
@@ -0,0 +1,90 @@
+#include "threadpool.h"
+
+ThreadPool::ThreadPool(int threadCount)
+    : job(nullptr)
+    , taskCount(0)
+    , nextTask(0)
+    , activeWorkers(0)
+    , generation(0)
+    , stopping(false) {
+    
+    // Le thread appelant compte comme worker 0
+    for (int i = 1; i < threadCount; i++) {
+        workers.emplace_back(&ThreadPool::workerLoop, this, i);
+    }
+}
+
+ThreadPool::~ThreadPool() {
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        stopping = true;
+    }
+    startCondition.notify_all();
+    
+    for (auto& worker : workers) {
+        worker.join();
+    }
+}
+
+void ThreadPool::workerLoop(int workerIndex) {
+    unsigned int lastGeneration = 0;
+    
+    while (true) {
+        {
+            std::unique_lock<std::mutex> lock(mutex);
+            startCondition.wait(lock, [&] { return stopping || generation != lastGeneration; });
+            if (stopping) return;
+            lastGeneration = generation;
+        }
+        
+        runTasks(workerIndex);
+        
+        {
+            std::lock_guard<std::mutex> lock(mutex);
+            if (--activeWorkers == 0) {
+                doneCondition.notify_one();
+            }
+        }
+    }
+}
+
+void ThreadPool::runTasks(int workerIndex) {
+    while (true) {
+        int task = nextTask.fetch_add(1, std::memory_order_relaxed);
+        if (task >= taskCount) break;
+        (*job)(task, workerIndex);
+    }
+}
+
+void ThreadPool::parallelFor(int count, const std::function<void(int task, int worker)>& fn) {
+    if (count <= 0) return;
+    
+    // Pas de workers (ou une seule tâche) : exécution directe
+    if (workers.empty() || count == 1) {
+        for (int task = 0; task < count; task++) {
+            fn(task, 0);
+        }
+        return;
+    }
+    
+    {
+        std::lock_guard<std::mutex> lock(mutex);
+        job = &fn;
+        taskCount = count;
+        nextTask.store(0, std::memory_order_relaxed);
+        activeWorkers = (int)workers.size();
+        generation++;
+    }
+    startCondition.notify_all();
+    
+    // Le thread appelant participe aussi
+    runTasks(0);
+    
+    std::unique_lock<std::mutex> lock(mutex);
+    doneCondition.wait(lock, [&] { return activeWorkers == 0; });
+    job = nullptr;
+}
+
+int ThreadPool::getThreadCount() const {
+    return (int)workers.size() + 1;
+}